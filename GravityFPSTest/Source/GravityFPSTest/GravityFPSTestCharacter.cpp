@@ -27,8 +27,12 @@
 #include "FlyingTimerComponent.h"
 #include "TP_WeaponComponent.h"
 #include "Components/BoxComponent.h"
+#include "Engine/Level.h"
 #include "DoorInterface.h"
 #include "MissileManager.h"
+#include "HUDModelSubsystem.h"
+#include "GravityCharacterMovementComponent.h"
+#include "GameplayPerfPanel.h"
 #include "GravityFPSTest/GravityFPSTestPlayerController.h"
 
 DEFINE_LOG_CATEGORY(LogTemplateCharacter);
@@ -56,11 +60,12 @@ DEFINE_LOG_CATEGORY(LogTemplateCharacter);
  * For more information regarding input and widgets, refer to the player controller class - GravityFPSTestPlayerController
  */
 
-AGravityFPSTestCharacter::AGravityFPSTestCharacter() : bIsThrusting(false), bIsWearingArmour(false), CurrentThrustInput(FVector::ZeroVector),
-FlyingVelocity(FVector::ZeroVector), bIsKeyDown(false), RotationWhenThrustersDisabled(FRotator::ZeroRotator), TimeSinceLastShot(0.0f),
+AGravityFPSTestCharacter::AGravityFPSTestCharacter(const FObjectInitializer& ObjectInitializer)
+: Super(ObjectInitializer.SetDefaultSubobjectClass<UGravityCharacterMovementComponent>(ACharacter::CharacterMovementComponentName)),
+bIsThrusting(false), bIsWearingArmour(false), CurrentThrustInput(FVector::ZeroVector), bIsKeyDown(false), RotationWhenThrustersDisabled(FRotator::ZeroRotator), TimeSinceLastShot(0.0f),
 ArmouredWeapon(EArmourWeaponState::Laser), NukeCharge(0.0f), InvisibilityTimer(Constants::c_InvisibilityDuration), bIsInvisible(false),
 HumanWeapon(EHumanWeaponState::Hands), MomentumSpeed(Constants::c_HumanBaseWalkingSpeed), bOnWall(false), bHoldingJumpButton(false),
-WallNormal(FVector::Zero()), bCanFly(true)
+WallNormal(FVector::Zero()), bWallRunContactsChanged(false), bCanFly(true)
 {
     // Character doesnt have an object at start
     bHoldingObject = false;
@@ -92,6 +97,8 @@ WallNormal(FVector::Zero()), bCanFly(true)
     GetCharacterMovement()->MaxWalkSpeed = Constants::c_ArmourBaseWalkingSpeed;
     GetCharacterMovement()->JumpZVelocity = Constants::c_ArmourBaseJumpHeight;
     GetCharacterMovement()->MaxWalkSpeedCrouched = Constants::c_ArmourBaseWalkingSpeed / 2;
+    // flight and wall running have their own gravity in the movement component, so this never changes
+    GetCharacterMovement()->GravityScale = Constants::c_GravityScale;
     JumpMaxCount = 1;
 
     // Component Initialization
@@ -106,19 +113,33 @@ WallNormal(FVector::Zero()), bCanFly(true)
     BiopadComponent = CreateDefaultSubobject<UBiopadComponent>(TEXT("BiopadComponent"));
     FuelComponent = CreateDefaultSubobject<UFlyingTimerComponent>(TEXT("FuelComponent"));
 
+    // The detector is its own WallRun object type and only overlaps level geometry, so it gets no overlap events for pawns, projectiles
+    // or physics objects flying past.
     PlayerWallDetector = CreateDefaultSubobject<UCapsuleComponent>(TEXT("PlayerWallDetector"));
     PlayerWallDetector->InitCapsuleSize(57.0f, 96.0f);
-    PlayerWallDetector->BodyInstance.SetCollisionProfileName("OverlapAll");
+    PlayerWallDetector->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
+    PlayerWallDetector->SetCollisionObjectType(Constants::c_WallRunChannel);
     PlayerWallDetector->SetGenerateOverlapEvents(true);
-    PlayerWallDetector->SetCollisionResponseToAllChannels(ECollisionResponse::ECR_Overlap);
+    PlayerWallDetector->SetCollisionResponseToAllChannels(ECollisionResponse::ECR_Ignore);
     PlayerWallDetector->SetCollisionResponseToChannel(ECC_WorldStatic, ECollisionResponse::ECR_Overlap);
+    PlayerWallDetector->SetCollisionResponseToChannel(ECC_WorldDynamic, ECollisionResponse::ECR_Overlap);
+    PlayerWallDetector->OnComponentBeginOverlap.AddDynamic(this, &AGravityFPSTestCharacter::OnWallDetectorBeginOverlap);
+    PlayerWallDetector->OnComponentEndOverlap.AddDynamic(this, &AGravityFPSTestCharacter::OnWallDetectorEndOverlap);
 
     PlayerWallDetector->SetupAttachment(RootComponent);
 
     GetCharacterMovement()->SetPlaneConstraintNormal(FVector::UpVector);
 }
 
-TArray<AActor*> AGravityFPSTestCharacter::GetActorsInSphereFromCamera(float Radius, float TraceDist, float ConeAngle, FCollisionQueryParams Params)
+UGravityCharacterMovementComponent* AGravityFPSTestCharacter::GetGravityMovement() const
+{
+    return Cast<UGravityCharacterMovementComponent>(GetCharacterMovement());
+}
+
+/// <summary>GetActorsInSphereFromCamera sweeps a sphere forwards from the player's view and returns everything it touches</summary>
+/// <param>Takes three float parameters, Radius, TraceDis, and ConeAngle, and the query params to use. The params are expected to already ignore the player.</param>
+/// <returns>return type is a TArray of AActor* that contains all actors found in the sweep.</returns>
+TArray<AActor*> AGravityFPSTestCharacter::GetActorsInSphereFromCamera(float Radius, float TraceDist, float ConeAngle, const FCollisionQueryParams& Params)
 {
     FVector ViewLocation;
     FRotator ViewRotation;
@@ -128,10 +149,10 @@ TArray<AActor*> AGravityFPSTestCharacter::GetActorsInSphereFromCamera(float Radi
     ViewLocation += Forward * Constants::c_OffsetDistance;
 
     TArray<FHitResult> Hits;
-    Params.AddIgnoredActor(this);
 
     float TraceDistance = TraceDist;
     FVector End = ViewLocation + Forward * TraceDistance;
+    FGameplayPerfCounters::CountSceneQuery(TEXT("MissileCone"));
     bool bHit = GetWorld()->SweepMultiByChannel(Hits, ViewLocation, End, FQuat::Identity, ECC_Visibility, FCollisionShape::MakeSphere(Radius), Params);
     if (bHit)
     {
@@ -161,21 +182,9 @@ TArray<AActor*> AGravityFPSTestCharacter::GetActorsInConeFromCamera(float Radius
     float ConeAngleDegrees = ConeAngle; // Controls how wide the cone is
     float CosConeAngle = FMath::Cos(FMath::DegreesToRadians(ConeAngleDegrees));
 
-    FCollisionQueryParams RaycastParams;
-    RaycastParams.AddIgnoredActor(this);
+    // ignores the player and every missile in flight, kept up to date by the subsystem as missiles come and go.
     UMissileManagerSubsystem* Subsystem = GetGameInstance()->GetSubsystem<UMissileManagerSubsystem>();
-    for (int32 i = Subsystem->ActiveMissiles.Num() - 1; i >= 0; --i)
-    {
-        if (Subsystem->ActiveMissiles[i].IsValid())
-        {
-            AMissileProjectile* Missile = Subsystem->ActiveMissiles[i].Get();
-            RaycastParams.AddIgnoredActor(Missile);
-        }
-        else
-        {
-            Subsystem->ActiveMissiles.RemoveAt(i);
-        }
-    }
+    const FCollisionQueryParams& RaycastParams = Subsystem->GetMissileQueryParams(this);
     TArray<AActor*> SphereActors = GetActorsInSphereFromCamera(Radius, TraceDist, ConeAngle, RaycastParams);
 
     // Filter based on cone angle
@@ -189,6 +198,7 @@ TArray<AActor*> AGravityFPSTestCharacter::GetActorsInConeFromCamera(float Radius
         {
             // Line trace to check visibility
             FHitResult VisibilityHit;
+            FGameplayPerfCounters::CountSceneQuery(TEXT("MissileOcclusion"));
             bool bBlocked = GetWorld()->LineTraceSingleByChannel(VisibilityHit, ViewLocation, ActorLocation, ECC_Visibility, RaycastParams);
             // Only add actor if not blocked
             if (!bBlocked || VisibilityHit.GetActor() == Actor)
@@ -260,6 +270,18 @@ void AGravityFPSTestCharacter::BeginPlay()
     {
         GunReference->RegisterComponent();
     }
+
+    // wall run geometry has to generate overlap events for PlayerWallDetector to see it, including anything streamed in later
+    TArray<AActor*> WallRunActors;
+    UGameplayStatics::GetAllActorsWithTag(GetWorld(), FName("WallRun"), WallRunActors);
+    EnableWallRunOverlaps(WallRunActors);
+    LevelAddedToWorldHandle = FWorldDelegates::LevelAddedToWorld.AddUObject(this, &AGravityFPSTestCharacter::HandleLevelAddedToWorld);
+}
+
+void AGravityFPSTestCharacter::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    FWorldDelegates::LevelAddedToWorld.Remove(LevelAddedToWorldHandle);
+    Super::EndPlay(EndPlayReason);
 }
 
 // TODO: add any new components that the player may have attached to their sockets to this function.
@@ -372,74 +394,134 @@ FName AGravityFPSTestCharacter::ConvertWeaponToString(int i)
     }
 }
 
+/// <summary>WallDetect is called by Tick while the unarmoured player is off the ground and moving. It starts or keeps up a wall run while
+/// the jump button is held next to a WallRun tagged wall, and ends it otherwise. It no longer queries the scene, the walls in reach are
+/// tracked by PlayerWallDetector's overlap events.</summary>
+/// <param>Takes no parameters</param>
+/// <returns>return type is void</returns>
 void AGravityFPSTestCharacter::WallDetect()
 {
-    FVector Start = PlayerWallDetector->GetComponentLocation();
-    FVector End = Start; // just checking for overlaps.
-    float CapsuleRadius = PlayerWallDetector->GetScaledCapsuleRadius();
-    float CapsuleHalfHeight = PlayerWallDetector->GetScaledCapsuleHalfHeight();
+    // if WallRunContacts is empty then it means we are no longer colliding with any walls, so reset the player physics back to normal.
+    if (bIsWearingArmour || !bHoldingJumpButton || WallRunContacts.IsEmpty() || !GetGravityMovement()->IsAirborne())
+    {
+        if (bOnWall)
+        {
+            ResetPhysics();
+        }
+        return;
+    }
 
-    TArray<FHitResult> HitResults;
+    if (bWallRunContactsChanged || !bOnWall)
+    {
+        bWallRunContactsChanged = false;
+        if (!UpdateWallNormal())
+        {
+            // nothing in reach gave a usable normal, so don't run along (or later jump off) a stale one. Tried again next tick.
+            WallNormal = FVector::ZeroVector;
+            if (bOnWall)
+            {
+                ResetPhysics();
+            }
+            return;
+        }
+    }
+    bOnWall = true;
+    GetGravityMovement()->StartWallRun(WallNormal);
+}
+
+/// <summary>UpdateWallNormal sweeps PlayerWallDetector's capsule in place and takes the normal of the closest hit on one of the walls in
+/// WallRunContacts. A sweep works on walls that only have complex collision too. WallNormal is left alone if none of them is hit.</summary>
+/// <param>Takes no parameters</param>
+/// <returns>return type is bool, whether a normal was found</returns>
+bool AGravityFPSTestCharacter::UpdateWallNormal()
+{
+    const FVector Start = PlayerWallDetector->GetComponentLocation();
     FCollisionQueryParams Params;
     Params.AddIgnoredActor(this);
+    // walls with only complex collision would be missed otherwise
+    Params.bTraceComplex = true;
 
-    bool bHit = GetWorld()->SweepMultiByChannel(
-        HitResults,
-        Start,
-        End,
-        FQuat::Identity,
-        ECC_Visibility,
-        FCollisionShape::MakeCapsule(CapsuleRadius, CapsuleHalfHeight),
-        Params
-    );
+    TArray<FHitResult> HitResults;
+    FGameplayPerfCounters::CountSceneQuery(TEXT("WallRunNormal"));
+    GetWorld()->SweepMultiByChannel(HitResults, Start, Start, FQuat::Identity, ECC_Visibility,
+        FCollisionShape::MakeCapsule(PlayerWallDetector->GetScaledCapsuleRadius(), PlayerWallDetector->GetScaledCapsuleHalfHeight()), Params);
 
-    ValidWallsInRange.Empty();
+    float ClosestDistance = TNumericLimits<float>::Max();
+    bool bFound = false;
+    for (const FHitResult& Hit : HitResults)
+    {
+        const UPrimitiveComponent* Wall = Hit.GetComponent();
+        const bool bIsContact = WallRunContacts.ContainsByPredicate([Wall](const TPair<TWeakObjectPtr<UPrimitiveComponent>, int32>& Contact)
+        {
+            return Contact.Key.Get() == Wall;
+        });
+        if (!Wall || !bIsContact || Hit.ImpactNormal.IsNearlyZero())
+        {
+            continue;
+        }
+        const float Distance = FVector::Dist(Start, Hit.ImpactPoint);
+        if (Distance < ClosestDistance)
+        {
+            ClosestDistance = Distance;
+            WallNormal = Hit.ImpactNormal;
+            bFound = true;
+        }
+    }
+    return bFound;
+}
 
-    FVector PlayerLocation = GetActorLocation();
-    if (bHit)
+/// <summary>EnableWallRunOverlaps turns on overlap events for every primitive of the WallRun tagged actors given. Placed static meshes have them off
+/// by default, and overlap events are only sent when both sides generate them, so without this PlayerWallDetector would never see those walls.</summary>
+/// <param>Takes the actors to check, untagged ones are skipped</param>
+/// <returns>return type is void</returns>
+void AGravityFPSTestCharacter::EnableWallRunOverlaps(const TArray<AActor*>& Actors)
+{
+    bool bEnabledAny = false;
+    for (AActor* Actor : Actors)
     {
-        for (const FHitResult& Hit : HitResults)
+        if (!Actor || !Actor->ActorHasTag("WallRun"))
         {
-            AActor* HitActor = Hit.GetActor();
-            if (!bIsWearingArmour && HitActor && HitActor->ActorHasTag("WallRun") && GetCharacterMovement()->IsFalling() && bHoldingJumpButton)
+            continue;
+        }
+        Actor->ForEachComponent<UPrimitiveComponent>(false, [&bEnabledAny](UPrimitiveComponent* Primitive)
+        {
+            if (!Primitive->GetGenerateOverlapEvents())
             {
-                bOnWall = true;
-                GetCharacterMovement()->GravityScale = Constants::c_WallGravity;
-                GetCharacterMovement()->bConstrainToPlane = true;
-                ValidWallsInRange.Add(Hit);
+                Primitive->SetGenerateOverlapEvents(true);
+                bEnabledAny = true;
             }
-        }
+        });
     }
 
-    // if ValidWallsInRange is empty then it means we are no longer colliding with any walls, so reset the player physics back to normal.
-    if (ValidWallsInRange.IsEmpty())
+    // pick up any of those walls the detector is already inside
+    if (bEnabledAny && PlayerWallDetector)
     {
-        ResetPhysics();
+        PlayerWallDetector->UpdateOverlaps();
     }
-    // if we have only one element, no need to find which one is closest, grab the normal and move on.
-    else if (ValidWallsInRange.Num() == 1)
+}
+
+void AGravityFPSTestCharacter::HandleLevelAddedToWorld(ULevel* Level, UWorld* World)
+{
+    if (Level && World == GetWorld())
     {
-        WallNormal = ValidWallsInRange[0].ImpactNormal;
+        EnableWallRunOverlaps(ObjectPtrDecay(Level->Actors));
     }
-    else // we have more than one element in our array, so loop through them to figure out which one is the closest and use that normal.
+}
+
+void AGravityFPSTestCharacter::OnWallDetectorBeginOverlap(UPrimitiveComponent* OverlappedComp, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
+{
+    if (OtherActor && OtherActor != this && OtherActor->ActorHasTag("WallRun"))
     {
-        FVector PlayerPosition = GetActorLocation();
-        FVector ClosestDistance = PlayerPosition - ValidWallsInRange[0].ImpactPoint;
-        FHitResult ClosestWall = ValidWallsInRange[0];
-        for (int i = 1; i < ValidWallsInRange.Num(); i++)
-        {
-            FVector Distance = PlayerPosition - ValidWallsInRange[i].ImpactPoint;
-            if (Distance.Size() < ClosestDistance.Size())
-            {
-                ClosestDistance = Distance;
-                ClosestWall = ValidWallsInRange[i];
-            }
-        }
-        WallNormal = ClosestWall.ImpactNormal;
+        WallRunContacts.AddUnique(MakeTuple(TWeakObjectPtr<UPrimitiveComponent>(OtherComp), OtherBodyIndex));
+        bWallRunContactsChanged = true;
     }
-    if (bOnWall)
+}
+
+void AGravityFPSTestCharacter::OnWallDetectorEndOverlap(UPrimitiveComponent* OverlappedComp, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex)
+{
+    if (WallRunContacts.Remove(MakeTuple(TWeakObjectPtr<UPrimitiveComponent>(OtherComp), OtherBodyIndex)) > 0)
     {
-        GetCharacterMovement()->SetPlaneConstraintNormal(WallNormal);
+        bWallRunContactsChanged = true;
     }
 }
 
@@ -467,7 +549,7 @@ UTP_WeaponComponent* AGravityFPSTestCharacter::GetAnyWeaponComponent(UWorld* Wor
 
 void AGravityFPSTestCharacter::SpacebarReleased()
 {
-    if (!bIsWearingArmour && bOnWall && GetCharacterMovement()->IsFalling())
+    if (!bIsWearingArmour && bOnWall && GetGravityMovement()->IsAirborne())
     {
         FVector JumpDirection = WallNormal;
         if (!(FMath::IsNearlyEqual(WallNormal.Z, 0.0f)))
@@ -491,50 +573,8 @@ void AGravityFPSTestCharacter::SpacebarReleased()
 void AGravityFPSTestCharacter::ResetPhysics()
 {
     bOnWall = false;
-    GetCharacterMovement()->bConstrainToPlane = false;
-    GetCharacterMovement()->GravityScale = Constants::c_GravityScale;
-}
-
-/// <summary>IsTouchingAnySurface is called by Tick to check if the player is touching the ground or not</summary>
-/// <param>Takes no parameters</param>
-/// <returns>return type is bool. Returns true if the player has contact with any surface.</returns>
-bool AGravityFPSTestCharacter::IsTouchingAnySurface()
-{
-    // Set up sweep parameters
-    FCollisionQueryParams Params;
-    Params.AddIgnoredActor(this);
-
-    FVector Start = GetActorLocation();
-    FVector End = Start; // Not moving  just checking overlap
-
-    UCapsuleComponent* Capsule = GetCapsuleComponent();
-    float CapsuleRadius = Capsule->GetScaledCapsuleRadius();
-    float CapsuleHalfHeight = Capsule->GetScaledCapsuleHalfHeight();
-
-    FHitResult HitResult;
-    bool bHit = GetWorld()->SweepSingleByChannel(
-        HitResult,
-        Start,
-        End,
-        GetActorQuat(),
-        ECC_Visibility,
-        FCollisionShape::MakeCapsule(CapsuleRadius, CapsuleHalfHeight + 10.0f),
-        Params
-    );
-
-    // Draw debug capsule
-#if 0
-    DrawDebugCapsule(
-        GetWorld(),
-        Start,
-        CapsuleHalfHeight,
-        CapsuleRadius,
-        FQuat::Identity,
-        bHit ? FColor::Green : FColor::Red,
-        false, 2.0f
-    );
-#endif
-    return bHit;
+    GetGravityMovement()->StopWallRun();
+    GetGravityMovement()->StopThrusting();
 }
 
 /// <summary>PlayerLaserSound is called by input from the player - it starts a sound effect that is activated when the left mouse button is clicked</summary>
@@ -600,45 +640,30 @@ void AGravityFPSTestCharacter::Tick(float DeltaTime)
 
     // Armour Behaviour
 
+    // the flight itself is integrated by the movement component's thrusting mode, all we do here is hand it the input
+    UGravityCharacterMovementComponent* Movement = GetGravityMovement();
     if (bIsWearingArmour && bIsThrusting && bCanFly)
     {
-        // Disable gravity while thrusting
-        GetCharacterMovement()->GravityScale = 0.f;
-
         // If no key is being held down, reset the thrust input to 0 to ensure that stored velocity isn't used again after landing. 
         if (!bIsKeyDown)
         {
             CurrentThrustInput = FVector::ZeroVector;
         }
-        if (GetCharacterMovement()->Velocity.Z < 0)
-        {
-            FVector CancelFall = GetCharacterMovement()->Velocity;
-            CancelFall.Z = 0;
-            GetCharacterMovement()->Velocity = CancelFall;
-        }
-
-        // Accelerate toward input
-        FlyingVelocity += CurrentThrustInput.GetSafeNormal() * Constants::c_ThrustAccel * DeltaTime;
+        Movement->SetThrustInput(CurrentThrustInput);
 
-        // Clamp to max flying speed
-        FlyingVelocity = FlyingVelocity.GetClampedToMaxSize(Constants::c_MaxFlyingSpeed);
-
-        // Apply custom flying velocity
-        GetCharacterMovement()->Velocity = FlyingVelocity;
-
-        if (GEngine)
+        // e.g. the thrusters were held down while the fuel ran out and it has since come back
+        if (!Movement->IsThrusting())
         {
-            //   GEngine->AddOnScreenDebugMessage(-1, 5.0f, FColor::Green, FString::Printf(TEXT("Current Velocity = (%f, %f, %f)"), FlyingVelocity.X, FlyingVelocity.Y, FlyingVelocity.Z));
-            //   GEngine->AddOnScreenDebugMessage(-1, 5.0f, FColor::Green, FString::Printf(TEXT("ThrustInput = %f, %f"), CurrentThrustInput.X, CurrentThrustInput.Y));
+            Movement->StartThrusting(0.0f);
         }
     }
     else if (bIsWearingArmour)
     {
-        // Reset for ground movement
-        GetCharacterMovement()->GravityScale = Constants::c_GravityScale;
-        if (IsTouchingAnySurface())
+        // out of fuel or thrusters released, back to normal falling and walking. Whatever we land on or bump into stops the stored flight.
+        Movement->StopThrusting();
+        if (Movement->IsTouchingSurface())
         {
-            FlyingVelocity = FVector::ZeroVector;
+            Movement->ResetFlyingVelocity();
         }
     }
 
@@ -663,6 +688,10 @@ void AGravityFPSTestCharacter::Tick(float DeltaTime)
         {
             GEngine->AddOnScreenDebugMessage(-1, 5.0f, FColor::Green, FString::Printf(TEXT("Invisibility Time = %f"), InvisibilityTimer));
         }
+        if (UHUDModelSubsystem* HUDModel = UHUDModelSubsystem::Get(GetController()))
+        {
+            HUDModel->SetInvisibilityTimeRemaining(InvisibilityTimer);
+        }
     }
 
     // Human Behaviour
@@ -689,7 +718,7 @@ void AGravityFPSTestCharacter::Tick(float DeltaTime)
             // GEngine->AddOnScreenDebugMessage(-1, 5.0f, FColor::Green, FString::Printf(TEXT("pct = %f"), pct));
             float LerpedValue = FMath::Lerp(Constants::c_HumanBaseJumpHeight, Constants::c_HumanMaxJumpHeight, pct);
             GetCharacterMovement()->JumpZVelocity = LerpedValue;
-            if (GetCharacterMovement()->IsFalling())
+            if (Movement->IsAirborne())
             {
                 WallDetect(); // this function will handle any wall running logic as necessary.
             }
@@ -727,7 +756,7 @@ void AGravityFPSTestCharacter::Move(const FInputActionValue& Value)
             AddMovementInput(GetActorForwardVector(), MovementVector.Y);
             AddMovementInput(GetActorRightVector(), MovementVector.X);
 
-            if (!bIsWearingArmour && !GetCharacterMovement()->IsFalling())
+            if (!bIsWearingArmour && !GetGravityMovement()->IsAirborne())
             {
                 MomentumSpeed += 1.0f;
                 MomentumSpeed = FMath::Clamp(MomentumSpeed, Constants::c_HumanBaseWalkingSpeed, Constants::c_HumanMaxWalkingSpeed);
@@ -789,17 +818,10 @@ void AGravityFPSTestCharacter::StartThrusters(const FInputActionValue& Value)
         {
             FuelComponent->UpdateFlightState(true);
         }
-        GetCharacterMovement()->DoJump(false);
-
-        // Apply that yaw rotation to the stored velocity
-        if (!FlyingVelocity.IsNearlyZero())
-        {
-            // Find the delta between the previous yaw rotation and the current one.
-            float YawDelta = GetActorRotation().Yaw - RotationWhenThrustersDisabled.Yaw;
 
-            FRotator DeltaRotator(0.f, YawDelta, 0.f);
-            FlyingVelocity = DeltaRotator.RotateVector(FlyingVelocity);
-        }
+        // Find the delta between the previous yaw rotation and the current one, the stored flying velocity is turned by it.
+        float YawDelta = GetActorRotation().Yaw - RotationWhenThrustersDisabled.Yaw;
+        GetGravityMovement()->StartThrusting(YawDelta);
     }
 }
 
@@ -814,6 +836,7 @@ void AGravityFPSTestCharacter::EndThrusters(const FInputActionValue& Value)
     {
         FuelComponent->UpdateFlightState(false);
     }
+    GetGravityMovement()->StopThrusting();
     RotationWhenThrustersDisabled = GetActorRotation();
 
 }
@@ -1008,6 +1031,10 @@ void AGravityFPSTestCharacter::ToggleInvisibility()
     if (bIsWearingArmour && ArmouredWeapon == EArmourWeaponState::Invisibility && !bIsInvisible)
     {
         bIsInvisible = true;
+        if (UHUDModelSubsystem* HUDModel = UHUDModelSubsystem::Get(pPlayerController))
+        {
+            HUDModel->SetInvisibilityTimeRemaining(InvisibilityTimer);
+        }
         pPlayerController->ShowInvisibilityWidget();
         Mesh1P->SetVisibility(false);
         GetMesh()->SetVisibility(false, true);
@@ -1050,6 +1077,7 @@ void AGravityFPSTestCharacter::DetectDoor()
     FVector End = ViewLocation + Forward * TraceDistance;
     FCollisionQueryParams Params;
     Params.AddIgnoredActor(this);
+    FGameplayPerfCounters::CountSceneQuery(TEXT("DoorDetect"));
     bool bHit = GetWorld()->LineTraceSingleByChannel(HitResult, ViewLocation, End, ECC_Visibility, Params);
     if (bHit && HitResult.GetActor() && HitResult.GetActor()->Implements<UDoorInterface>())
     {
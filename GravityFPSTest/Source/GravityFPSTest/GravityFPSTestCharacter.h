@@ -18,6 +18,7 @@ class UAudioComponent;
 class USoundBase;
 class UBiopadComponent;
 class UCapsuleComponent;
+class UGravityCharacterMovementComponent;
 class UFlyingTimerComponent;
 class UTP_WeaponComponent;
 class ACubeProjectile;
@@ -74,7 +75,7 @@ class AGravityFPSTestCharacter : public ACharacter, public ITargetableInterface
 
 	
 public:
-	AGravityFPSTestCharacter();
+	AGravityFPSTestCharacter(const FObjectInitializer& ObjectInitializer);
 
 	// Getters and Setters
 	bool IsThrusting() { return bIsThrusting; };
@@ -83,7 +84,8 @@ public:
 	bool IsInvisible() { return bIsInvisible; };
 	FVector GetSavedLocation() { return SavedLocation; };
 	UBiopadComponent* GetBiopadComponent() { return BiopadComponent; };
-	TArray<AActor*> GetActorsInSphereFromCamera(float Radius, float TraceDist, float ConeAngle, FCollisionQueryParams Params);
+	UGravityCharacterMovementComponent* GetGravityMovement() const;
+	TArray<AActor*> GetActorsInSphereFromCamera(float Radius, float TraceDist, float ConeAngle, const FCollisionQueryParams& Params);
 	TArray<AActor*> GetActorsInConeFromCamera(float Radius, float TraceDist, float ConeAngle);
 	float GetInvisibilityCountDownDuration() { return InvisibilityTimer; };
 
@@ -104,6 +106,7 @@ public:
 
 protected:
 	virtual void BeginPlay();	
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 	void HideSocketComponents();
 	void ShowSelectedSocketComponent();
@@ -119,6 +122,15 @@ protected:
 
 	// Human functions
 	void WallDetect();
+	bool UpdateWallNormal();
+	void EnableWallRunOverlaps(const TArray<AActor*>& Actors);
+	void HandleLevelAddedToWorld(ULevel* Level, UWorld* World);
+
+	UFUNCTION()
+	void OnWallDetectorBeginOverlap(UPrimitiveComponent* OverlappedComp, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult);
+
+	UFUNCTION()
+	void OnWallDetectorEndOverlap(UPrimitiveComponent* OverlappedComp, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex);
 	UTP_WeaponComponent* GetAnyWeaponComponent(UWorld* World);
 
 	// Human data members
@@ -129,18 +141,19 @@ protected:
 	bool bOnWall;
 	bool bHoldingJumpButton;
 	FVector WallNormal;
-	TArray<FHitResult> ValidWallsInRange;
+	// WallRun tagged bodies currently overlapping PlayerWallDetector, kept up to date by its overlap events. Overlaps begin and end per body,
+	// so each is keyed by its component and body index, an instanced mesh has one per instance. The wall normal is only worked out again
+	// when this changes.
+	TArray<TPair<TWeakObjectPtr<UPrimitiveComponent>, int32>> WallRunContacts;
+	bool bWallRunContactsChanged;
+	FDelegateHandle LevelAddedToWorldHandle;
 
 	UTP_WeaponComponent* GunReference;
 	ACubeProjectile* CubeReference;
 
-	// Flying functions
-	bool IsTouchingAnySurface();
-
 	// Flying data members
 	bool bIsThrusting;
 	FVector CurrentThrustInput;
-	FVector FlyingVelocity;
 	FRotator RotationWhenThrustersDisabled;
 
 	// Shooting data members
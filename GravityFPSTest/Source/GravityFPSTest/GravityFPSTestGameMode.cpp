@@ -3,6 +3,7 @@
 #include "GravityFPSTestGameMode.h"
 #include "GravityFPSTestCharacter.h"
 #include "UObject/ConstructorHelpers.h"
+#include "CanvasHUD.h"
 
 AGravityFPSTestGameMode::AGravityFPSTestGameMode()
 	: Super()
@@ -12,3 +13,13 @@ AGravityFPSTestGameMode::AGravityFPSTestGameMode()
 	DefaultPawnClass = PlayerPawnClassFinder.Class;
 
 }
+
+void AGravityFPSTestGameMode::InitGame(const FString& MapName, const FString& Options, FString& ErrorMessage)
+{
+	Super::InitGame(MapName, Options, ErrorMessage);
+
+	if (ACanvasHUD::IsRequested(Options))
+	{
+		HUDClass = ACanvasHUD::StaticClass();
+	}
+}
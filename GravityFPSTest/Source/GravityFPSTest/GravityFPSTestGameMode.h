@@ -13,6 +13,9 @@ class AGravityFPSTestGameMode : public AGameModeBase
 
 public:
 	AGravityFPSTestGameMode();
+
+	// Swaps in the single pass canvas HUD when it was asked for (-CanvasHUD or ?CanvasHUD).
+	virtual void InitGame(const FString& MapName, const FString& Options, FString& ErrorMessage) override;
 };
 
 
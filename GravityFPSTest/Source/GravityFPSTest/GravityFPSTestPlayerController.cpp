@@ -14,6 +14,10 @@
 #include "Public/FlyingTimerComponent.h"
 #include "BiopadComponent.h"
 #include "IconsUserWidget.h"
+#include "HUDModelSubsystem.h"
+#include "CanvasHUD.h"
+#include "Engine/AssetManager.h"
+#include "Engine/StreamableManager.h"
 
 void AGravityFPSTestPlayerController::BeginPlay()
 {
@@ -28,81 +32,91 @@ void AGravityFPSTestPlayerController::BeginPlay()
         Subsystem->AddMappingContext(InputMappingContext, 0);
 
         UE_LOG(LogTemp, Warning, TEXT("BeginPlay"));
+    }
 
-        if (HelmetWidgetClass)
-        {
-            HelmetWidget = CreateWidget<UHelmetUserWidget>(GetWorld(), HelmetWidgetClass);
-            if (HelmetWidget)
-            {
-                HelmetWidget->AddToViewport();
-                if (MyCharacter && MyCharacter->IsWearingArmour())
-                {
-                    HelmetWidget->PlayFadeIn();
-                }
-            }
-        }
+    // only the widgets shown from the start are created here, the rest wait until they are first used
+    WithHUDWidget<UBiopadUserWidget>(BiopadWidgetClass, BiopadWidget, true, [](UBiopadUserWidget&) {});
+    WithHUDWidget<UIconsUserWidget>(IconsWidgetClass, IconWidget, true, [](UIconsUserWidget&) {});
 
-        if (InvisibilityWidgetClass)
-        {
-            InvisibilityWidget = CreateWidget<UInvisibilityHUDUserWidget>(GetWorld(), InvisibilityWidgetClass);
-            if (InvisibilityWidget)
-            {
-                InvisibilityWidget->AddToViewport();
-                InvisibilityWidget->SetVisibility(ESlateVisibility::Hidden);
-            }
-        }
+    if (MyCharacter && MyCharacter->IsWearingArmour())
+    {
+        WithHUDWidget<UHelmetUserWidget>(HelmetWidgetClass, HelmetWidget, true, [](UHelmetUserWidget& Widget) { Widget.PlayFadeIn(); });
+        ShowRadar();
+        ShowFuelWidget();
+    }
+}
 
-        if (RadarWidgetClass)
-        {
-            RadarWidget = CreateWidget<URadarUserWidget>(GetWorld(), RadarWidgetClass);
-            if (RadarWidget)
-            {
-                RadarWidget->AddToViewport();
-                if (MyCharacter && !MyCharacter->IsWearingArmour())
-                {
-                    RadarWidget->SetVisibility(ESlateVisibility::Hidden);
-                }
-            }
-        }
+/// <summary>
+/// WithHUDWidget runs OnReady on a HUD widget once it exists. If the widget has not been created yet and bCreate is set, its class is
+/// streamed in asynchronously and the widget is created and added to the viewport when the load completes. Without bCreate, the call is only
+/// queued if the widget is already on its way, so hiding a widget that was never shown does not load anything.
+/// </summary>
+/// <param>Takes the widget's soft class, the member holding the widget, whether to create it and what to do with it</param>
+/// <returns>return type is void</returns>
+template<typename WidgetT>
+void AGravityFPSTestPlayerController::WithHUDWidget(const TSoftClassPtr<WidgetT>& WidgetClass, WidgetT*& Widget, bool bCreate, TFunction<void(WidgetT&)> OnReady)
+{
+    if (Widget)
+    {
+        OnReady(*Widget);
+        return;
+    }
+    if (WidgetClass.IsNull() || IsUsingCanvasHUD())
+    {
+        return;
+    }
+
+    const FSoftObjectPath ClassPath = WidgetClass.ToSoftObjectPath();
+    const bool bPending = PendingWidgetClasses.Contains(ClassPath);
+    if (!bCreate && !bPending)
+    {
+        return;
+    }
 
-        if (BiopadWidgetClass)
+    if (!bPending)
+    {
+        if (UClass* LoadedClass = WidgetClass.Get())
         {
-            BiopadWidget = CreateWidget<UBiopadUserWidget>(GetWorld(), BiopadWidgetClass);
-            if (BiopadWidget)
+            Widget = CreateWidget<WidgetT>(GetWorld(), LoadedClass);
+            if (Widget)
             {
-                BiopadWidget->AddToViewport();
+                Widget->AddToViewport();
+                OnReady(*Widget);
             }
+            return;
         }
+        PendingWidgetClasses.Add(ClassPath);
+    }
 
-        if (FuelWidgetClass)
+    TWeakObjectPtr<AGravityFPSTestPlayerController> WeakThis(this);
+    UAssetManager::GetStreamableManager().RequestAsyncLoad(ClassPath, FStreamableDelegate::CreateLambda(
+        [WeakThis, WidgetClass, &Widget, bCreate, OnReady = MoveTemp(OnReady), ClassPath]()
         {
-            FuelWidget = CreateWidget<UFuelWidget>(GetWorld(), FuelWidgetClass);
-            if (FuelWidget)
+            // Widget refers to a member of the controller, so it can only be touched while the controller is still around
+            if (AGravityFPSTestPlayerController* Controller = WeakThis.Get())
             {
-                FuelWidget->AddToViewport();
-                if (MyCharacter && !MyCharacter->IsWearingArmour())
+                Controller->PendingWidgetClasses.Remove(ClassPath);
+                if (!WidgetClass.Get())
                 {
-                    FuelWidget->SetVisibility(ESlateVisibility::Hidden);
+                    UE_LOG(LogTemp, Warning, TEXT("Failed to load HUD widget class %s"), *ClassPath.ToString());
+                    return;
                 }
+                Controller->WithHUDWidget<WidgetT>(WidgetClass, Widget, bCreate, OnReady);
             }
-        }
+        }));
+}
 
-        if (IconsWidgetClass)
-        {
-            IconWidget = CreateWidget<UIconsUserWidget>(GetWorld(), IconsWidgetClass);
-            if (IconWidget)
-            {
-                IconWidget->AddToViewport();
-            }
-        }
-    }
+bool AGravityFPSTestPlayerController::IsUsingCanvasHUD() const
+{
+    return Cast<ACanvasHUD>(MyHUD) != nullptr;
 }
 
 void AGravityFPSTestPlayerController::HandleEquipmentChanged(FName name)
 {
-    if (IconWidget)
+    // the icons widget picks this up from the HUD model
+    if (UHUDModelSubsystem* HUDModel = UHUDModelSubsystem::Get(this))
     {
-        IconWidget->SetDisplayLabel(name);
+        HUDModel->SetEquipment(name);
     }
 }
 
@@ -281,7 +295,10 @@ void AGravityFPSTestPlayerController::RemoveLastSelectedObject()
 
 void AGravityFPSTestPlayerController::SwitchBiopadDisplay()
 {
-    BiopadWidget->ToggleDistance();
+    if (BiopadWidget)
+    {
+        BiopadWidget->ToggleDistance();
+    }
 }
 
 void AGravityFPSTestPlayerController::DetectDoor()
@@ -296,7 +313,7 @@ void AGravityFPSTestPlayerController::SwapArmour()
     FTimerHandle FuelDelayHandle;
     if (MyCharacter->IsWearingArmour())
     {
-        HelmetWidget->PlayFadeIn();
+        WithHUDWidget<UHelmetUserWidget>(HelmetWidgetClass, HelmetWidget, true, [](UHelmetUserWidget& Widget) { Widget.PlayFadeIn(); });
         GetWorldTimerManager().SetTimer(
             RadarDelayHandle,
             this,                            
@@ -316,7 +333,7 @@ void AGravityFPSTestPlayerController::SwapArmour()
     }
     else
     {
-        HelmetWidget->PlayFadeOut();
+        WithHUDWidget<UHelmetUserWidget>(HelmetWidgetClass, HelmetWidget, false, [](UHelmetUserWidget& Widget) { Widget.PlayFadeOut(); });
         GetWorldTimerManager().SetTimer(
             RadarDelayHandle,
             this,                             
@@ -332,56 +349,38 @@ void AGravityFPSTestPlayerController::SwapArmour()
             0.5f,                             
             false
         );
-        InvisibilityWidget->SetVisibility(ESlateVisibility::Hidden);
+        HideInvisibilityWidget();
     }
 }
 
 void AGravityFPSTestPlayerController::ShowInvisibilityWidget()
 {
-    if (InvisibilityWidget)
-    {
-        InvisibilityWidget->SetVisibility(ESlateVisibility::Visible);
-    }
+    WithHUDWidget<UInvisibilityHUDUserWidget>(InvisibilityWidgetClass, InvisibilityWidget, true, [](UWidget& Widget) { Widget.SetVisibility(ESlateVisibility::Visible); });
 }
 
 void AGravityFPSTestPlayerController::HideInvisibilityWidget()
 {
-    if (InvisibilityWidget)
-    {
-        InvisibilityWidget->SetVisibility(ESlateVisibility::Hidden);
-    }
+    WithHUDWidget<UInvisibilityHUDUserWidget>(InvisibilityWidgetClass, InvisibilityWidget, false, [](UWidget& Widget) { Widget.SetVisibility(ESlateVisibility::Hidden); });
 }
 
 void AGravityFPSTestPlayerController::ShowFuelWidget()
 {
-    if (FuelWidget)
-    {
-        FuelWidget->SetVisibility(ESlateVisibility::Visible);
-    }
+    WithHUDWidget<UFuelWidget>(FuelWidgetClass, FuelWidget, true, [](UWidget& Widget) { Widget.SetVisibility(ESlateVisibility::Visible); });
 }
 
 void AGravityFPSTestPlayerController::HideFuelWidget()
 {
-    if (FuelWidget)
-    {
-        FuelWidget->SetVisibility(ESlateVisibility::Hidden);
-    }
+    WithHUDWidget<UFuelWidget>(FuelWidgetClass, FuelWidget, false, [](UWidget& Widget) { Widget.SetVisibility(ESlateVisibility::Hidden); });
 }
 
 void AGravityFPSTestPlayerController::ShowRadar()
 {
-    if (RadarWidget)
-    {
-        RadarWidget->SetVisibility(ESlateVisibility::Visible);
-    }
+    WithHUDWidget<URadarUserWidget>(RadarWidgetClass, RadarWidget, true, [](UWidget& Widget) { Widget.SetVisibility(ESlateVisibility::Visible); });
 }
 
 void AGravityFPSTestPlayerController::HideRadar()
 {
-    if (RadarWidget)
-    {
-        RadarWidget->SetVisibility(ESlateVisibility::Hidden);
-    }
+    WithHUDWidget<URadarUserWidget>(RadarWidgetClass, RadarWidget, false, [](UWidget& Widget) { Widget.SetVisibility(ESlateVisibility::Hidden); });
 }
 
 void AGravityFPSTestPlayerController::AcknowledgePossession(APawn* InPawn)
@@ -161,30 +161,41 @@ protected:
 	UFUNCTION()
 	void HandleEquipmentChanged(FName name);
 
+	// The canvas HUD draws everything itself, none of the UMG widgets are created while it is in use.
+	bool IsUsingCanvasHUD() const;
+
+	template<typename WidgetT>
+	void WithHUDWidget(const TSoftClassPtr<WidgetT>& WidgetClass, WidgetT*& Widget, bool bCreate, TFunction<void(WidgetT&)> OnReady);
+
+	// The HUD widget classes are soft references, so none of them are loaded with the controller. Each widget is only created (and its class
+	// streamed in) the first time it is needed, the armour widgets for example are never loaded in a session where armour is not worn.
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = UI)
-	TSubclassOf<UHelmetUserWidget> HelmetWidgetClass;
+	TSoftClassPtr<UHelmetUserWidget> HelmetWidgetClass;
 	UHelmetUserWidget* HelmetWidget;
 	
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = UI)
-	TSubclassOf<UInvisibilityHUDUserWidget> InvisibilityWidgetClass;
+	TSoftClassPtr<UInvisibilityHUDUserWidget> InvisibilityWidgetClass;
 	UInvisibilityHUDUserWidget* InvisibilityWidget;
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = UI)
-	TSubclassOf<URadarUserWidget> RadarWidgetClass;
+	TSoftClassPtr<URadarUserWidget> RadarWidgetClass;
 	URadarUserWidget* RadarWidget;
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = UI)
-	TSubclassOf<UBiopadUserWidget> BiopadWidgetClass;
+	TSoftClassPtr<UBiopadUserWidget> BiopadWidgetClass;
 	UBiopadUserWidget* BiopadWidget;
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = UI)
-	TSubclassOf<UFuelWidget> FuelWidgetClass;
+	TSoftClassPtr<UFuelWidget> FuelWidgetClass;
 	UFuelWidget* FuelWidget;
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = UI)
-	TSubclassOf<UIconsUserWidget> IconsWidgetClass;
+	TSoftClassPtr<UIconsUserWidget> IconsWidgetClass;
 	UIconsUserWidget* IconWidget;
 
+	// Widget classes that are still streaming in. Requests made in the meantime are queued behind the load and applied in order.
+	TSet<FSoftObjectPath> PendingWidgetClasses;
+
 	// pointer to the controlled pawn
 	AGravityFPSTestCharacter* MyCharacter;
 
@@ -4,13 +4,13 @@
 #include "BiopadComponent.h"
 #include "Constants.h"
 #include "Camera/CameraComponent.h"
+#include "GameplayPerfPanel.h"
 
 // Sets default values for this component's properties
 UBiopadComponent::UBiopadComponent()
 {
-	// Set this component to be initialized when the game starts, and to be ticked every frame.  You can turn these features
-	// off to improve performance if you don't need them.
-	PrimaryComponentTick.bCanEverTick = true;
+	// Display data is built when the biopad widget asks for it, nothing needs to happen every frame.
+	PrimaryComponentTick.bCanEverTick = false;
 
 	// ...
 }
@@ -30,12 +30,13 @@ void UBiopadComponent::TrySelect()
     FCollisionQueryParams Params;
     Params.AddIgnoredActor(Owner);
 
+    FGameplayPerfCounters::CountSceneQuery(TEXT("BiopadScan"));
     if (GetWorld()->LineTraceSingleByChannel(HitResult, Start, End, ECC_Visibility, Params))
     {
         AActor* HitActor = HitResult.GetActor();
-        if (HitActor && !SelectedActors.Contains(HitActor))
+        if (HitActor && !IsTracked(HitActor))
         {
-            SelectedActors.AddUnique(HitActor); // AddUnique should not be needed here, but I'm trying to be defensive
+            AddEntry(HitActor);
         //    UE_LOG(LogTemp, Log, TEXT("Selected: %s"), *HitActor->GetName());
         }
     }
@@ -45,11 +46,121 @@ void UBiopadComponent::TrySelect()
 
 void UBiopadComponent::RemoveLastSelected()
 {
-    if (SelectedActors.Num() > 0)
+    // handles of actors that have already gone are skipped
+    while (SelectionOrder.IsValidIndex(SelectionHead))
     {
-        AActor* RemovedActor = SelectedActors[0];
-        SelectedActors.RemoveAt(0);
-        UE_LOG(LogTemp, Log, TEXT("Removed: %s"), *RemovedActor->GetName());
+        const FBiopadHandle Handle = SelectionOrder[SelectionHead++];
+        if (IsValidHandle(Handle))
+        {
+            UE_LOG(LogTemp, Log, TEXT("Removed: %s"), *Entries[Handle.Index].DisplayName);
+            RemoveEntry(Handle);
+            break;
+        }
+    }
+
+    // drop the consumed part of the queue once it is at least half of it
+    if (SelectionHead > 0 && SelectionHead * 2 >= SelectionOrder.Num())
+    {
+        SelectionOrder.RemoveAt(0, SelectionHead, false);
+        SelectionHead = 0;
+    }
+}
+
+FBiopadHandle UBiopadComponent::AddEntry(AActor* Actor)
+{
+    FBiopadEntry Entry;
+    Entry.Actor = Actor;
+    Entry.SoftActor = Actor;
+    Entry.Serial = NextSerial++;
+    Entry.DisplayName = Actor->GetName();
+    Entry.LastTransform = Actor->GetActorTransform();
+
+    FBiopadHandle Handle;
+    Handle.Serial = Entry.Serial;
+    Handle.Index = Entries.Add(MoveTemp(Entry));
+
+    HandlesByPath.Add(Entries[Handle.Index].SoftActor.ToSoftObjectPath(), Handle);
+    WatchActor(Actor);
+    SelectionOrder.Add(Handle);
+    // new entries start at the end and are moved into place by the next sort
+    SortedHandles.Add(Handle);
+    bSelectionChanged = true;
+    return Handle;
+}
+
+void UBiopadComponent::RemoveEntry(const FBiopadHandle& Handle)
+{
+    if (!IsValidHandle(Handle))
+    {
+        return;
+    }
+    // the handle is left in SelectionOrder and SortedHandles, where it is now stale and gets skipped
+    UnwatchActor(Entries[Handle.Index].Actor.Get());
+    HandlesByPath.Remove(Entries[Handle.Index].SoftActor.ToSoftObjectPath());
+    Entries.RemoveAt(Handle.Index);
+    bSelectionChanged = true;
+}
+
+void UBiopadComponent::WatchActor(AActor* Actor)
+{
+    if (Actor)
+    {
+        Actor->OnEndPlay.AddUniqueDynamic(this, &UBiopadComponent::HandleTrackedActorEndPlay);
+    }
+}
+
+void UBiopadComponent::UnwatchActor(AActor* Actor)
+{
+    if (Actor)
+    {
+        Actor->OnEndPlay.RemoveDynamic(this, &UBiopadComponent::HandleTrackedActorEndPlay);
+    }
+}
+
+/// <summary>HandleTrackedActorEndPlay is called when a tracked actor leaves play. If it left because its level or cell was streamed out, the
+/// entry keeps its last known transform and lets go of the actor. Anything else (e.g. being destroyed) stops tracking it.</summary>
+/// <param>Takes the actor leaving play and the reason why</param>
+/// <returns>return type is void</returns>
+void UBiopadComponent::HandleTrackedActorEndPlay(AActor* Actor, EEndPlayReason::Type EndPlayReason)
+{
+    const FBiopadHandle* Handle = HandlesByPath.Find(FSoftObjectPath(Actor));
+    if (!Handle || !IsValidHandle(*Handle))
+    {
+        return;
+    }
+
+    if (EndPlayReason == EEndPlayReason::RemovedFromWorld)
+    {
+        FBiopadEntry& Entry = Entries[Handle->Index];
+        Entry.LastTransform = Actor->GetActorTransform();
+        Entry.Actor.Reset();
+        Entry.bStreamedOut = true;
+        UnwatchActor(Actor);
+    }
+    else
+    {
+        RemoveEntry(*Handle);
+    }
+}
+
+/// <summary>UpdateSortedOrder drops stale handles from the distance order and re-sorts it nearest first. It uses an insertion sort on last
+/// update's order, which is close to linear when actors only moved a little since.</summary>
+/// <returns>return type is void</returns>
+void UBiopadComponent::UpdateSortedOrder()
+{
+    SortedHandles.RemoveAll([this](const FBiopadHandle& Handle) { return !IsValidHandle(Handle); });
+
+    for (int32 i = 1; i < SortedHandles.Num(); ++i)
+    {
+        const FBiopadHandle Handle = SortedHandles[i];
+        const double DistanceSquared = Entries[Handle.Index].DistanceSquared;
+        int32 j = i - 1;
+        while (j >= 0 && Entries[SortedHandles[j].Index].DistanceSquared > DistanceSquared)
+        {
+            SortedHandles[j + 1] = SortedHandles[j];
+            --j;
+        }
+        SortedHandles[j + 1] = Handle;
     }
 }
 
@@ -64,30 +175,75 @@ void UBiopadComponent::BeginPlay()
 }
 
 
-// Called every frame
-void UBiopadComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+/// <summary>RefreshDisplayData rebuilds the display rows if the selection changed or the player or any tracked actor moved since the last time.
+/// Otherwise the rows from last time are still right and nothing is done.</summary>
+/// <returns>return type is void</returns>
+void UBiopadComponent::RefreshDisplayData()
 {
-	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
-
-    DisplayData.Empty();
-
-    if (AActor* Owner = GetOwner())
+    AActor* Owner = GetOwner();
+    if (!Owner)
     {
-        FVector PlayerLocation = Owner->GetActorLocation();
+        return;
+    }
 
-        for (AActor* Actor : SelectedActors)
+    const FVector PlayerLocation = Owner->GetActorLocation();
+    bool bDirty = bSelectionChanged || !PlayerLocation.Equals(LastPlayerLocation);
+    for (auto It = Entries.CreateIterator(); It; ++It)
+    {
+        AActor* Actor = It->Actor.Get();
+        if (It->bStreamedOut)
         {
-            if (IsValid(Actor))
+            // see if its cell has been loaded again, until then it stays where it was last seen
+            Actor = It->SoftActor.Get();
+            if (!IsValid(Actor))
             {
-                FVector Distance = Actor->GetActorLocation() - PlayerLocation;
+                continue;
+            }
+            It->Actor = Actor;
+            It->bStreamedOut = false;
+            WatchActor(Actor);
+        }
+        else if (!IsValid(Actor))
+        {
+            // stopped existing since it was selected
+            HandlesByPath.Remove(It->SoftActor.ToSoftObjectPath());
+            It.RemoveCurrent();
+            bDirty = true;
+            continue;
+        }
+        const FTransform& Transform = Actor->GetActorTransform();
+        if (!Transform.Equals(It->LastTransform))
+        {
+            It->LastTransform = Transform;
+            bDirty = true;
+        }
+    }
+    if (!bDirty)
+    {
+        return;
+    }
+    bSelectionChanged = false;
+    LastPlayerLocation = PlayerLocation;
 
-                FActorInfoDisplay Info;
-                Info.Name = Actor->GetName();
-                Info.Distance = Distance;
+    for (FBiopadEntry& Entry : Entries)
+    {
+        Entry.Offset = Entry.LastTransform.GetLocation() - PlayerLocation;
+        Entry.DistanceSquared = Entry.Offset.SizeSquared();
+    }
 
-                DisplayData.Add(Info);
-            }
+    UpdateSortedOrder();
+
+    // rows are overwritten in place, names are only copied when a different actor ends up in that row
+    DisplayData.SetNum(SortedHandles.Num());
+    for (int32 i = 0; i < SortedHandles.Num(); ++i)
+    {
+        const FBiopadEntry& Entry = Entries[SortedHandles[i].Index];
+        FActorInfoDisplay& Info = DisplayData[i];
+        if (!Info.Name.Equals(Entry.DisplayName, ESearchCase::CaseSensitive))
+        {
+            Info.Name = Entry.DisplayName;
         }
+        Info.Distance = Entry.Offset;
     }
+    ++DisplayDataVersion;
 }
-
@@ -0,0 +1,52 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "BiopadListWidget.h"
+#include "Widgets/Text/STextBlock.h"
+#include "Styling/CoreStyle.h"
+
+UBiopadListWidget::UBiopadListWidget(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer), ColorAndOpacity(FLinearColor::White)
+{
+    Font = FCoreStyle::GetDefaultFontStyle("Regular", 12);
+}
+
+void UBiopadListWidget::SetRows(const TArray<TSharedPtr<FBiopadRowText>>& Rows)
+{
+    Items = Rows;
+    if (MyListView.IsValid())
+    {
+        MyListView->RequestListRefresh();
+    }
+}
+
+void UBiopadListWidget::ReleaseSlateResources(bool bReleaseChildren)
+{
+    Super::ReleaseSlateResources(bReleaseChildren);
+    MyListView.Reset();
+}
+
+TSharedRef<SWidget> UBiopadListWidget::RebuildWidget()
+{
+    MyListView = SNew(SListView<TSharedPtr<FBiopadRowText>>)
+        .ListItemsSource(&Items)
+        .SelectionMode(ESelectionMode::None)
+        .OnGenerateRow_UObject(this, &UBiopadListWidget::GenerateRow);
+    return MyListView.ToSharedRef();
+}
+
+TSharedRef<ITableRow> UBiopadListWidget::GenerateRow(TSharedPtr<FBiopadRowText> Row, const TSharedRef<STableViewBase>& OwnerTable)
+{
+    // the text is read from the row, so a rebuilt row shows up without regenerating its widget
+    TWeakPtr<FBiopadRowText> WeakRow = Row;
+    return SNew(STableRow<TSharedPtr<FBiopadRowText>>, OwnerTable)
+        [
+            SNew(STextBlock)
+            .Font(Font)
+            .ColorAndOpacity(ColorAndOpacity)
+            .Text_Lambda([WeakRow]()
+            {
+                TSharedPtr<FBiopadRowText> PinnedRow = WeakRow.Pin();
+                return PinnedRow.IsValid() ? PinnedRow->Text : FText::GetEmpty();
+            })
+        ];
+}
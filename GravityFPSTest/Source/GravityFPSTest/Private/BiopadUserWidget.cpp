@@ -3,10 +3,12 @@
 
 #include "BiopadUserWidget.h"
 #include "BiopadComponent.h"
-#include "Kismet/GameplayStatics.h"
+#include "HUDModelSubsystem.h"
 #include "Constants.h"
 #include "Components/TextBlock.h"
-#include "GravityFPSTest/GravityFPSTestCharacter.h"
+#include "Misc/StringBuilder.h"
+#include "Components/PanelWidget.h"
+#include "Blueprint/WidgetTree.h"
 
 bool UBiopadUserWidget::Initialize()
 {
@@ -19,53 +21,157 @@ bool UBiopadUserWidget::Initialize()
 	return true;
 }
 
-void UBiopadUserWidget::NativeTick(const FGeometry& MyGeometry, float InDeltaTime)
+void UBiopadUserWidget::NativeConstruct()
 {
-	AController* pController = UGameplayStatics::GetPlayerController(GetWorld(), 0);
-	APawn* Pawn = pController->GetPawn();
-	PlayerCharacter = Cast<AGravityFPSTestCharacter>(Pawn);
-	if (PlayerCharacter)
-	{
-		UBiopadComponent* BiopadComponent = PlayerCharacter->GetBiopadComponent();
-		TArray<FActorInfoDisplay> ActorsToDisplay = BiopadComponent->GetActorDisplayData();
-		FString Result = "";
-		for (const FActorInfoDisplay& Actor : ActorsToDisplay)
-		{	
-			if (DistanceInsteadOfCoordinates)
-			{
-				FString ActorInfo = FString::Printf(TEXT("%s | %s\n"),
-					*Actor.Name,
-					*FormatSignedInt(FMath::RoundToInt(Actor.Distance.Length())));
-				Result += ActorInfo;
-			}
-			else
+	Super::NativeConstruct();
+
+	// the list takes over the text block's slot so it sits wherever the blueprint put the text
+	if (!BiopadList && BiopadScreenText && WidgetTree)
+	{
+		if (UPanelWidget* Parent = BiopadScreenText->GetParent())
+		{
+			UBiopadListWidget* NewList = WidgetTree->ConstructWidget<UBiopadListWidget>(UBiopadListWidget::StaticClass(), TEXT("BiopadList"));
+			NewList->Font = BiopadScreenText->GetFont();
+			NewList->ColorAndOpacity = BiopadScreenText->GetColorAndOpacity();
+			if (Parent->ReplaceChild(BiopadScreenText, NewList))
 			{
-				FString ActorInfo = FString::Printf(TEXT("%s | X:%s Y:%s Z:%s\n"),
-					*Actor.Name,
-					*FormatSignedInt(FMath::RoundToInt(Actor.Distance.X)),
-					*FormatSignedInt(FMath::RoundToInt(Actor.Distance.Y)),
-					*FormatSignedInt(FMath::RoundToInt(Actor.Distance.Z)));
-				Result += ActorInfo;
+				BiopadList = NewList;
 			}
 		}
-		if (BiopadScreenText)
+	}
+	if (UHUDModelSubsystem* HUDModel = GetHUDModel())
+	{
+		DisplayRows(HUDModel->GetBiopadRows());
+		HUDModel->OnBiopadRowsChanged.AddUObject(this, &UBiopadUserWidget::DisplayRows);
+	}
+
+	GetWorld()->GetTimerManager().SetTimer(RefreshRowsHandle, this, &UBiopadUserWidget::RefreshRows, Constants::c_BiopadRefreshInterval, true);
+	RegisterHUDTimer(RefreshRowsHandle);
+}
+
+void UBiopadUserWidget::RefreshRows()
+{
+	// the model only calls back into DisplayRows if the rows changed
+	if (UHUDModelSubsystem* HUDModel = GetHUDModel())
+	{
+		HUDModel->RefreshBiopadRows();
+	}
+}
+
+void UBiopadUserWidget::NativeDestruct()
+{
+	if (UHUDModelSubsystem* HUDModel = GetHUDModel())
+	{
+		HUDModel->OnBiopadRowsChanged.RemoveAll(this);
+	}
+	Super::NativeDestruct();
+}
+
+void UBiopadUserWidget::ToggleDistance()
+{
+	DistanceInsteadOfCoordinates = !DistanceInsteadOfCoordinates;
+	if (UHUDModelSubsystem* HUDModel = GetHUDModel())
+	{
+		DisplayRows(HUDModel->GetBiopadRows());
+	}
+}
+
+/// <summary>DisplayRows brings the biopad text up to date with the given rows. Only rows whose rounded distance, coordinates or name changed
+/// are rebuilt, and the text block is only given new text if at least one row did.</summary>
+/// <param>Takes the rows published by the HUD model</param>
+/// <returns>return type is void</returns>
+void UBiopadUserWidget::DisplayRows(const TArray<FActorInfoDisplay>& ActorsToDisplay)
+{
+	bool bRowsAddedOrRemoved = RowTexts.Num() != ActorsToDisplay.Num();
+	bool bChanged = bRowsAddedOrRemoved;
+	while (RowTexts.Num() < ActorsToDisplay.Num())
+	{
+		RowTexts.Add(MakeShared<FBiopadRowText>());
+	}
+	RowTexts.SetNum(ActorsToDisplay.Num());
+	for (int32 i = 0; i < ActorsToDisplay.Num(); ++i)
+	{
+		bChanged |= UpdateRowText(*RowTexts[i], ActorsToDisplay[i]);
+	}
+	if (!bChanged)
+	{
+		return;
+	}
+
+	if (BiopadList)
+	{
+		// rows that only changed text are picked up by the list on its own
+		if (bRowsAddedOrRemoved)
 		{
-			BiopadScreenText->SetText(FText::FromString(Result));
+			BiopadList->SetRows(RowTexts);
 		}
-	//	UE_LOG(LogTemp, Warning, TEXT("Selected: %s"), *Result);
+		return;
+	}
+
+	ScreenText.Reset();
+	for (const TSharedPtr<FBiopadRowText>& Row : RowTexts)
+	{
+		ScreenText += Row->Text.ToString();
+		ScreenText += TEXT('\n');
+	}
+	if (BiopadScreenText)
+	{
+		BiopadScreenText->SetText(FText::FromString(ScreenText));
+	}
+}
+
+/// <summary>UpdateRowText rebuilds one row's text if what it displays changed since it was last built.</summary>
+/// <param>Takes the cached row and the actor info it should show</param>
+/// <returns>return type is bool, true if the row's text changed</returns>
+bool UBiopadUserWidget::UpdateRowText(FBiopadRowText& Row, const FActorInfoDisplay& Actor) const
+{
+	const FIntVector Coordinates(FMath::RoundToInt(Actor.Distance.X), FMath::RoundToInt(Actor.Distance.Y), FMath::RoundToInt(Actor.Distance.Z));
+	const int32 Distance = FMath::RoundToInt(Actor.Distance.Length());
+	if (Row.bBuilt && Row.bDistanceMode == DistanceInsteadOfCoordinates && Row.Name.Equals(Actor.Name, ESearchCase::CaseSensitive)
+		&& (DistanceInsteadOfCoordinates ? Row.Distance == Distance : Row.Coordinates == Coordinates))
+	{
+		return false;
+	}
+
+	if (!Row.Name.Equals(Actor.Name, ESearchCase::CaseSensitive))
+	{
+		Row.Name = Actor.Name;
+	}
+	Row.Coordinates = Coordinates;
+	Row.Distance = Distance;
+	Row.bDistanceMode = DistanceInsteadOfCoordinates;
+	Row.bBuilt = true;
+
+	// built on the stack, only the final text is allocated
+	TStringBuilder<128> Builder;
+	Builder << Actor.Name << TEXT(" | ");
+	if (DistanceInsteadOfCoordinates)
+	{
+		AppendSignedInt(Builder, Distance);
 	}
+	else
+	{
+		Builder << TEXT("X:");
+		AppendSignedInt(Builder, Coordinates.X);
+		Builder << TEXT(" Y:");
+		AppendSignedInt(Builder, Coordinates.Y);
+		Builder << TEXT(" Z:");
+		AppendSignedInt(Builder, Coordinates.Z);
+	}
+
+	Row.Text = FText::FromString(FString(Builder.ToView()));
+	return true;
 }
 
-FString UBiopadUserWidget::FormatSignedInt(int32 Value)
+void UBiopadUserWidget::AppendSignedInt(FStringBuilderBase& Builder, int32 Value)
 {
 	// This is because the negative symbol is treated as an extra character when parsing and I would like to avoid this
 	if (Value < 0)
 	{
-		return FString::Printf(TEXT("-%05d"), FMath::Abs(Value));
+		Builder.Appendf(TEXT("-%05d"), FMath::Abs(Value));
 	}
 	else
 	{
-		return FString::Printf(TEXT(" %05d"), Value);
+		Builder.Appendf(TEXT(" %05d"), Value);
 	}
-	return FString();
 }
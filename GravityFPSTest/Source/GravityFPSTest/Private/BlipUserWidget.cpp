@@ -1,14 +0,0 @@
-// Fill out your copyright notice in the Description page of Project Settings.
-
-
-#include "BlipUserWidget.h"
-
-void UBlipUserWidget::NativeConstruct()
-{
-
-}
-
-void UBlipUserWidget::NativeTick(const FGeometry& MyGeometry, float InDeltaTime)
-{
-
-}
@@ -0,0 +1,221 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "CanvasHUD.h"
+#include "Engine/Canvas.h"
+#include "Engine/Font.h"
+#include "Engine/Texture2D.h"
+#include "Kismet/GameplayStatics.h"
+#include "Misc/CommandLine.h"
+#include "Engine/AssetManager.h"
+#include "Engine/StreamableManager.h"
+#include "HUDModelSubsystem.h"
+#include "GravityFPSTest/GravityFPSTestCharacter.h"
+
+namespace CanvasHUDLayout
+{
+    static const float Margin = 32.0f;
+    static const FVector2D FuelBarSize(320.0f, 16.0f);
+    static const float IconSize = 64.0f;
+    static const float BlipSize = 6.0f;
+    static const int32 RadarRingSegments = 32;
+    static const FLinearColor FuelColor(0.1f, 0.6f, 1.0f, 1.0f);
+    static const FLinearColor PanelColor(0.0f, 0.0f, 0.0f, 0.4f);
+    static const FLinearColor BlipColor(1.0f, 0.1f, 0.1f, 1.0f);
+}
+
+ACanvasHUD::ACanvasHUD()
+{
+    Font = TSoftObjectPtr<UFont>(FSoftObjectPath(TEXT("/Engine/EngineFonts/Roboto.Roboto")));
+    HelmetOverlay = TSoftObjectPtr<UTexture2D>(FSoftObjectPath(TEXT("/Game/Images/HelmetOverlay.HelmetOverlay")));
+
+    // the same textures the icons widget blueprint maps each equipment to
+    EquipmentIcons.Add(TEXT("Laser"), TSoftObjectPtr<UTexture2D>(FSoftObjectPath(TEXT("/Game/Images/Laser.Laser"))));
+    EquipmentIcons.Add(TEXT("Cube"), TSoftObjectPtr<UTexture2D>(FSoftObjectPath(TEXT("/Game/Images/Cube.Cube"))));
+    EquipmentIcons.Add(TEXT("Missile"), TSoftObjectPtr<UTexture2D>(FSoftObjectPath(TEXT("/Game/Images/Missile.Missile"))));
+    EquipmentIcons.Add(TEXT("Nuke"), TSoftObjectPtr<UTexture2D>(FSoftObjectPath(TEXT("/Game/Images/Nuke.Nuke"))));
+    EquipmentIcons.Add(TEXT("BioPad"), TSoftObjectPtr<UTexture2D>(FSoftObjectPath(TEXT("/Game/Images/biological_pad.biological_pad"))));
+}
+
+bool ACanvasHUD::IsRequested(const FString& Options)
+{
+    return FParse::Param(FCommandLine::Get(), TEXT("CanvasHUD")) || UGameplayStatics::HasOption(Options, TEXT("CanvasHUD"));
+}
+
+void ACanvasHUD::BeginPlay()
+{
+    Super::BeginPlay();
+
+    // nothing is drawn with an asset until it has loaded, the handle keeps them loaded until EndPlay
+    TArray<FSoftObjectPath> AssetPaths = { Font.ToSoftObjectPath(), HelmetOverlay.ToSoftObjectPath() };
+    for (const TPair<FName, TSoftObjectPtr<UTexture2D>>& Icon : EquipmentIcons)
+    {
+        AssetPaths.Add(Icon.Value.ToSoftObjectPath());
+    }
+    AssetPaths.RemoveAll([](const FSoftObjectPath& Path) { return Path.IsNull(); });
+    AssetsHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(AssetPaths);
+
+    if (UHUDModelSubsystem* HUDModel = GetHUDModel())
+    {
+        HUDModel->OnEquipmentChanged.AddUObject(this, &ACanvasHUD::HandleEquipmentChanged);
+    }
+
+    Detection.Init(this);
+    GetWorldTimerManager().SetTimer(DetectionTimerHandle, this, &ACanvasHUD::UpdateDetection, FMath::Max(DetectionInterval, 0.01f), true);
+}
+
+void ACanvasHUD::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    if (UHUDModelSubsystem* HUDModel = GetHUDModel())
+    {
+        HUDModel->OnEquipmentChanged.RemoveAll(this);
+    }
+    GetWorldTimerManager().ClearTimer(DetectionTimerHandle);
+    if (AssetsHandle.IsValid())
+    {
+        AssetsHandle->ReleaseHandle();
+        AssetsHandle.Reset();
+    }
+    IconToDisplay = nullptr;
+    Super::EndPlay(EndPlayReason);
+}
+
+UHUDModelSubsystem* ACanvasHUD::GetHUDModel() const
+{
+    return UHUDModelSubsystem::Get(GetOwningPlayerController());
+}
+
+/// <summary>DrawHUD draws the whole HUD for this frame. Everything it shows comes from the HUD model and the player character, the same
+/// values the UMG widgets are driven by, so the two HUDs can be compared like for like.</summary>
+/// <returns>return type is void</returns>
+void ACanvasHUD::DrawHUD()
+{
+    Super::DrawHUD();
+
+    AGravityFPSTestCharacter* Character = Cast<AGravityFPSTestCharacter>(GetOwningPawn());
+    UHUDModelSubsystem* HUDModel = GetHUDModel();
+    if (!Character || !HUDModel)
+    {
+        return;
+    }
+    const bool bArmoured = Character->IsWearingArmour();
+
+    // the helmet fades in and out over a second, like the widget does
+    HelmetOpacity = FMath::FInterpConstantTo(HelmetOpacity, bArmoured ? 1.0f : 0.0f, RenderDelta, 1.0f);
+    IconOpacity = FMath::Max(IconOpacity - RenderDelta, 0.0f);
+
+    DrawHelmet(HelmetOpacity);
+    if (bArmoured)
+    {
+        DrawRadar(Character);
+        DrawFuel(HUDModel->GetFuelPercent());
+        if (Character->IsInvisible())
+        {
+            DrawInvisibility(HUDModel->GetInvisibilitySecondsRemaining());
+        }
+    }
+    DrawEquipmentIcon();
+}
+
+void ACanvasHUD::DrawHelmet(float Opacity)
+{
+    UTexture2D* Overlay = HelmetOverlay.Get();
+    if (Overlay && Opacity > 0.0f)
+    {
+        DrawTexture(Overlay, 0.0f, 0.0f, Canvas->ClipX, Canvas->ClipY, 0.0f, 0.0f, 1.0f, 1.0f, FLinearColor(1.0f, 1.0f, 1.0f, Opacity));
+    }
+}
+
+void ACanvasHUD::DrawFuel(float Percent)
+{
+    using namespace CanvasHUDLayout;
+    const float X = (Canvas->ClipX - FuelBarSize.X) * 0.5f;
+    const float Y = Canvas->ClipY - Margin - FuelBarSize.Y;
+    DrawRect(PanelColor, X, Y, FuelBarSize.X, FuelBarSize.Y);
+    DrawRect(FuelColor, X, Y, FuelBarSize.X * FMath::Clamp(Percent, 0.0f, 1.0f), FuelBarSize.Y);
+}
+
+void ACanvasHUD::DrawInvisibility(int32 SecondsRemaining)
+{
+    const FString CountDown = FString::Printf(TEXT("%2d:%02d"), SecondsRemaining / 60, SecondsRemaining % 60);
+    // falls back to the engine's default font until ours has loaded
+    UFont* CountDownFont = Font.Get();
+    float Width, Height;
+    GetTextSize(CountDown, Width, Height, CountDownFont);
+    DrawText(CountDown, FLinearColor::White, (Canvas->ClipX - Width) * 0.5f, CanvasHUDLayout::Margin, CountDownFont);
+}
+
+void ACanvasHUD::DrawEquipmentIcon()
+{
+    using namespace CanvasHUDLayout;
+    if (IconToDisplay && IconOpacity > 0.0f)
+    {
+        DrawTexture(IconToDisplay, Canvas->ClipX - Margin - IconSize, Canvas->ClipY - Margin - IconSize, IconSize, IconSize,
+            0.0f, 0.0f, 1.0f, 1.0f, FLinearColor(1.0f, 1.0f, 1.0f, IconOpacity));
+    }
+}
+
+/// <summary>DrawRadar draws the radar ring in the bottom left corner and a blip for every contact in range, projected the same way as the
+/// radar widget's blips.</summary>
+/// <param>Takes the pawn the radar is centred on</param>
+/// <returns>return type is void</returns>
+void ACanvasHUD::DrawRadar(const APawn* Pawn)
+{
+    using namespace CanvasHUDLayout;
+    const FVector2D Origin(Margin, Canvas->ClipY - Margin - 2.0f * RadarRadius);
+    const FVector2D Center = Origin + FVector2D(RadarRadius);
+
+    for (int32 i = 0; i < RadarRingSegments; ++i)
+    {
+        float Sin0, Cos0, Sin1, Cos1;
+        FMath::SinCos(&Sin0, &Cos0, UE_TWO_PI * i / RadarRingSegments);
+        FMath::SinCos(&Sin1, &Cos1, UE_TWO_PI * (i + 1) / RadarRingSegments);
+        DrawLine(Center.X + Cos0 * RadarRadius, Center.Y + Sin0 * RadarRadius, Center.X + Cos1 * RadarRadius, Center.Y + Sin1 * RadarRadius, FLinearColor::White);
+    }
+
+    const FVector PlayerLocation = Pawn->GetActorLocation();
+    // same rotation offset as the radar widget, so forward is up
+    const float RadarYaw = -(Pawn->GetActorRotation().Yaw + 90.0f);
+    const float ExtrapolationTime = FMath::Clamp(GetWorld()->GetTimeSeconds() - Detection.GetSampleTime(), 0.0f, 2.0f * DetectionInterval);
+
+    const TArray<FRadarContact>& Contacts = Detection.GetContacts();
+    ProjectionBatch.Reset(Contacts.Num());
+    for (const FRadarContact& Contact : Contacts)
+    {
+        if (!Contact.Actor.IsValid()) continue;
+
+        ProjectionBatch.Add(Contact.Location + Contact.Velocity * ExtrapolationTime - PlayerLocation);
+    }
+    ProjectionBatch.Pad();
+
+    BlipPositions.Reset();
+    FRadarProjection(RadarYaw, RadarRange, RadarRadius).ProjectBatch(ProjectionBatch, BlipPositions);
+    for (const FVector2f& Position : BlipPositions)
+    {
+        DrawRect(BlipColor, Origin.X + Position.X - BlipSize * 0.5f, Origin.Y + Position.Y - BlipSize * 0.5f, BlipSize, BlipSize);
+    }
+}
+
+void ACanvasHUD::HandleEquipmentChanged(FName Equipment)
+{
+    UTexture2D* FoundIcon = EquipmentIcons.FindRef(Equipment).Get();
+    if (!FoundIcon)
+    {
+        // the fist, gun and invisibility have no icon, the last one just keeps fading out like it does in the icons widget
+        return;
+    }
+    IconToDisplay = FoundIcon;
+    IconOpacity = 1.0f;
+}
+
+/// <summary>UpdateDetection starts the same radar detection the radar widget runs. It is skipped while the radar is not shown.</summary>
+/// <returns>return type is void</returns>
+void ACanvasHUD::UpdateDetection()
+{
+    AGravityFPSTestCharacter* Character = Cast<AGravityFPSTestCharacter>(GetOwningPawn());
+    if (!Character || !Character->IsWearingArmour())
+    {
+        return;
+    }
+    Detection.Update(GetWorld(), Character, RadarRange, TEXT("CanvasRadar"));
+}
@@ -4,6 +4,7 @@
 #include "Kismet/GameplayStatics.h"
 #include "Engine/StaticMeshActor.h"
 #include "ClosestActorUtils.h"
+#include "Constants.h"
 
 /// <summary>Finds the closest Actor to the provided reference location in the given world.</summary>
 /// <param name="position, f">Takes a UWorld, Actor, and Actor subclass as parameters for the search, actor list and actors to ignore (if any) are also required.".</param>
@@ -44,3 +45,79 @@ AActor* UClosestActorUtils::FindClosestRelevantActor(UWorld* World, AActor* Refe
     TArray<AActor*> EmptyArray;
     return FindClosestRelevantActor(World, ReferenceActor, ActorList, EmptyArray, IncludeStaticMesh);
 }
+
+/// <summary>Scores every candidate four at a time over flat, padded arrays of distances, view angles and bounds, then pulls out the best MaxTargets
+/// with a partial heap sort instead of sorting the whole list. Each term is normalized to 0-1: closer, more centred and bigger on screen all score higher.</summary>
+/// <param>Takes the view location and direction, the cone angle the candidates were found in (degrees), the candidate list and how many targets to keep.</param>
+/// <returns>return type is void, the selected targets are written into OutTargets ordered from best to worst.</returns>
+void UClosestActorUtils::SelectTopScoringTargets(const FVector& ViewLocation, const FVector& ViewForward, float ConeAngle, const TArray<AActor*>& Candidates,
+    int32 MaxTargets, TArray<AActor*>& OutTargets)
+{
+    OutTargets.Reset();
+    const int32 Num = Candidates.Num();
+    if (Num == 0 || MaxTargets <= 0)
+    {
+        return;
+    }
+
+    // Gather into flat arrays padded to a multiple of four so the scoring kernel below has no pointer chasing and no scalar tail.
+    // Padded lanes are zeroed, they score finite values and are never looked at.
+    const int32 Padded = Align(Num, 4);
+    TArray<float> Distances, CosAngles, Radii, Scores;
+    Distances.SetNumZeroed(Padded);
+    CosAngles.SetNumZeroed(Padded);
+    Radii.SetNumZeroed(Padded);
+    Scores.SetNumUninitialized(Padded);
+    for (int32 i = 0; i < Num; ++i)
+    {
+        const USceneComponent* Root = Candidates[i]->GetRootComponent();
+        const FVector ToActor = Candidates[i]->GetActorLocation() - ViewLocation;
+        const float Distance = ToActor.Size();
+        Distances[i] = Distance;
+        CosAngles[i] = Distance > UE_KINDA_SMALL_NUMBER ? FVector::DotProduct(ToActor, ViewForward) / Distance : 1.0f;
+        Radii[i] = Root ? Root->Bounds.SphereRadius : 0.0f;
+    }
+
+    const float CosCone = FMath::Cos(FMath::DegreesToRadians(ConeAngle));
+    const VectorRegister4Float Zero = VectorZeroFloat();
+    const VectorRegister4Float One = VectorOneFloat();
+    const VectorRegister4Float InvRange = VectorSetFloat1(1.0f / Constants::c_TargetScoreRange);
+    const VectorRegister4Float CosConeV = VectorSetFloat1(CosCone);
+    const VectorRegister4Float InvConeWidth = VectorSetFloat1(1.0f / FMath::Max(1.0f - CosCone, UE_KINDA_SMALL_NUMBER));
+    const VectorRegister4Float InvReferenceSize = VectorSetFloat1(1.0f / Constants::c_TargetScoreReferenceSize);
+    const VectorRegister4Float DistanceWeight = VectorSetFloat1(Constants::c_TargetScoreDistanceWeight);
+    const VectorRegister4Float AngleWeight = VectorSetFloat1(Constants::c_TargetScoreAngleWeight);
+    const VectorRegister4Float SizeWeight = VectorSetFloat1(Constants::c_TargetScoreSizeWeight);
+    for (int32 i = 0; i < Padded; i += 4)
+    {
+        const VectorRegister4Float Distance = VectorLoad(&Distances[i]);
+        const VectorRegister4Float CosAngle = VectorLoad(&CosAngles[i]);
+        const VectorRegister4Float Radius = VectorLoad(&Radii[i]);
+
+        const VectorRegister4Float DistanceScore = VectorSubtract(One, VectorMin(VectorMultiply(Distance, InvRange), One));
+        const VectorRegister4Float AngleScore = VectorMin(VectorMax(VectorMultiply(VectorSubtract(CosAngle, CosConeV), InvConeWidth), Zero), One);
+        // apparent size is roughly radius over distance
+        const VectorRegister4Float SizeScore = VectorMin(VectorMultiply(VectorDivide(Radius, VectorMax(Distance, One)), InvReferenceSize), One);
+
+        VectorStore(VectorMultiplyAdd(DistanceScore, DistanceWeight, VectorMultiplyAdd(AngleScore, AngleWeight, VectorMultiply(SizeScore, SizeWeight))), &Scores[i]);
+    }
+
+    // Partial sort: heapify is O(n), and we only pop the k we need.
+    TArray<int32> Order;
+    Order.SetNumUninitialized(Num);
+    for (int32 i = 0; i < Num; ++i)
+    {
+        Order[i] = i;
+    }
+    auto HigherScore = [&Scores](int32 A, int32 B) { return Scores[A] > Scores[B]; };
+    Order.Heapify(HigherScore);
+
+    const int32 Count = FMath::Min(MaxTargets, Num);
+    OutTargets.Reserve(Count);
+    for (int32 i = 0; i < Count; ++i)
+    {
+        int32 Best;
+        Order.HeapPop(Best, HigherScore, false);
+        OutTargets.Add(Candidates[Best]);
+    }
+}
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Engine/EngineTypes.h"
 
 /**
  *
@@ -24,6 +25,8 @@ public:
 
 	inline static const float c_HorizontalPush = 600.0f;
 	inline static const float c_WallGravity = 0.3f;
+	// Object channel of the player's wall detector, see DefaultEngine.ini
+	inline static const ECollisionChannel c_WallRunChannel = ECC_GameTraceChannel2;
 
 	// Flying Constants
 	inline static const float c_ThrustAccel = 3000.0f;
@@ -34,6 +37,28 @@ public:
 
 	// Missile Constants
 	inline static const float c_MissileSpawnDelay = 0.05f;
+	inline static const float c_MissileConeRadius = 3600.0f;
+	inline static const float c_MissileConeTraceDistance = 15000000000.0f;
+	inline static const float c_MissileConeAngle = 45.0f;
+
+	// Missile Guidance Constants
+	inline static const float c_MissileNavigationConstant = 4.0f;
+	inline static const float c_MissilePursuitGain = 10.0f;
+	inline static const float c_MissileMaxGuidanceAccel = 60000.0f;
+	inline static const float c_MissileMaxLeadTime = 2.0f;
+
+	// Missile Targeting Snapshot Constants
+	inline static const float c_TargetSnapshotPositionTolerance = 50.0f;
+	inline static const float c_TargetSnapshotAngleTolerance = 2.0f;
+	inline static const float c_TargetSnapshotTimeToLive = 0.25f;
+
+	// Missile Target Scoring Constants
+	inline static const int32 c_MissileMaxLocks = 4;
+	inline static const float c_TargetScoreRange = 20000.0f;
+	inline static const float c_TargetScoreReferenceSize = 0.1f;
+	inline static const float c_TargetScoreDistanceWeight = 0.4f;
+	inline static const float c_TargetScoreAngleWeight = 0.4f;
+	inline static const float c_TargetScoreSizeWeight = 0.2f;
 
 	// Tank Rifle Constants
 	inline static const float c_NukeChargeRate = 10.0f;
@@ -48,6 +73,7 @@ public:
 
 	// Biopad Constants
 	inline static const float c_TraceRange = 200.0f;
+	inline static const float c_BiopadRefreshInterval = 0.1f;
 
 	// UI icon Size Constants
 	inline static const float c_IconSize = 64.0f;
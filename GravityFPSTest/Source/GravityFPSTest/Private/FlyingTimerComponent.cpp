@@ -3,7 +3,7 @@
 
 #include "FlyingTimerComponent.h"
 #include "Constants.h"
-#include "FuelWidget.h"
+#include "HUDModelSubsystem.h"
 #include "GravityFPSTest/GravityFPSTestPlayerController.h"
 #include "GravityFPSTest/GravityFPSTestCharacter.h"
 
@@ -56,7 +56,10 @@ void UFlyingTimerComponent::UpdateFuel()
 			bIsThrusting = false;
 			Character->SetFlightAbility(false);
 		}
-		Player->GetFuelWidget()->SetBarPercent(PCT);
+		if (UHUDModelSubsystem* HUDModel = UHUDModelSubsystem::Get(Player))
+		{
+			HUDModel->SetFuelPercent(PCT);
+		}
 	}
 }
 
@@ -2,6 +2,7 @@
 
 
 #include "FuelWidget.h"
+#include "HUDModelSubsystem.h"
 
 bool UFuelWidget::Initialize()
 {
@@ -14,9 +15,23 @@ bool UFuelWidget::Initialize()
 	return true;
 }
 
-void UFuelWidget::NativeTick(const FGeometry& MyGeometry, float InDeltaTime)
+void UFuelWidget::NativeConstruct()
 {
+    Super::NativeConstruct();
+    if (UHUDModelSubsystem* HUDModel = GetHUDModel())
+    {
+        SetBarPercent(HUDModel->GetFuelPercent());
+        HUDModel->OnFuelChanged.AddUObject(this, &UFuelWidget::SetBarPercent);
+    }
+}
 
+void UFuelWidget::NativeDestruct()
+{
+    if (UHUDModelSubsystem* HUDModel = GetHUDModel())
+    {
+        HUDModel->OnFuelChanged.RemoveAll(this);
+    }
+    Super::NativeDestruct();
 }
 
 void UFuelWidget::SetBarPercent(float Percent)
@@ -0,0 +1,151 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "GameplayPerfPanel.h"
+#include "Engine/GameViewportClient.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "HAL/IConsoleManager.h"
+#include "Blueprint/UserWidget.h"
+#include "Widgets/Layout/SBorder.h"
+#include "Widgets/Text/STextBlock.h"
+#include "Styling/CoreStyle.h"
+#include "Misc/StringBuilder.h"
+#include "CubeProjectile.h"
+#include "LaserBeamProjectile.h"
+#include "MissileProjectile.h"
+#include "TankRifleProjectile.h"
+#include "MissileManager.h"
+#include "HUDModelSubsystem.h"
+#include "GravityFPSTest/GravityFPSTestProjectile.h"
+
+bool FGameplayPerfCounters::bEnabled = false;
+TMap<FName, int32> FGameplayPerfCounters::SceneQueries;
+int32 FGameplayPerfCounters::RadarContacts = 0;
+
+TWeakPtr<SGameplayPerfPanel> SGameplayPerfPanel::OpenPanel;
+
+static FAutoConsoleCommandWithWorld GameplayPerfPanelCommand(
+    TEXT("Perf.GameplayPanel"),
+    TEXT("Shows or hides the live gameplay performance panel."),
+    FConsoleCommandWithWorldDelegate::CreateStatic(&SGameplayPerfPanel::Toggle)
+);
+
+void SGameplayPerfPanel::Construct(const FArguments& InArgs)
+{
+    World = InArgs._World;
+    LastSampleFrame = GFrameCounter;
+    FGameplayPerfCounters::bEnabled = true;
+    FGameplayPerfCounters::SceneQueries.Reset();
+    FGameplayPerfCounters::RadarContacts = 0;
+
+    ChildSlot
+    .HAlign(HAlign_Left)
+    .VAlign(VAlign_Top)
+    .Padding(16.0f, 96.0f)
+    [
+        SNew(SBorder)
+        .BorderImage(FCoreStyle::Get().GetBrush("BlackBrush"))
+        .Padding(8.0f)
+        [
+            SNew(STextBlock)
+            .Font(FCoreStyle::GetDefaultFontStyle("Mono", 9))
+            .Text_Lambda([this]() { return Text; })
+        ]
+    ];
+
+    RegisterActiveTimer(InArgs._SampleInterval, FWidgetActiveTimerDelegate::CreateSP(this, &SGameplayPerfPanel::Sample));
+}
+
+SGameplayPerfPanel::~SGameplayPerfPanel()
+{
+    FGameplayPerfCounters::bEnabled = false;
+    FGameplayPerfCounters::SceneQueries.Reset();
+}
+
+/// <summary>Toggle opens the panel over the world's game viewport, or removes it if it is already open.</summary>
+/// <param>Takes the world the console command was run in</param>
+/// <returns>return type is void</returns>
+void SGameplayPerfPanel::Toggle(UWorld* World)
+{
+    UGameViewportClient* Viewport = World ? World->GetGameViewport() : nullptr;
+    if (!Viewport)
+    {
+        return;
+    }
+
+    if (TSharedPtr<SGameplayPerfPanel> Panel = OpenPanel.Pin())
+    {
+        Viewport->RemoveViewportWidgetContent(Panel.ToSharedRef());
+        OpenPanel.Reset();
+        return;
+    }
+
+    TSharedRef<SGameplayPerfPanel> Panel = SNew(SGameplayPerfPanel).World(World);
+    // above every HUD widget
+    Viewport->AddViewportWidgetContent(Panel, 1000);
+    OpenPanel = Panel;
+}
+
+/// <summary>Sample reads every counter and rebuilds the panel's text. Scene queries are averaged over the frames since the last sample.</summary>
+/// <param>Takes the current time and the time since the last sample</param>
+/// <returns>return type is EActiveTimerReturnType, the timer keeps running until the panel is closed</returns>
+EActiveTimerReturnType SGameplayPerfPanel::Sample(double InCurrentTime, float InDeltaTime)
+{
+    UWorld* SampledWorld = World.Get();
+    if (!SampledWorld)
+    {
+        return EActiveTimerReturnType::Continue;
+    }
+
+    const double Frames = FMath::Max<double>(GFrameCounter - LastSampleFrame, 1);
+    LastSampleFrame = GFrameCounter;
+
+    TStringBuilder<1024> Builder;
+    Builder.Appendf(TEXT("Game thread      %6.2f ms\n"), FPlatformTime::ToMilliseconds(GGameThreadTime));
+
+    Builder.Append(TEXT("Projectiles\n"));
+    auto AppendActorCount = [&Builder, SampledWorld](UClass* Class)
+    {
+        int32 Count = 0;
+        for (TActorIterator<AActor> It(SampledWorld, Class); It; ++It)
+        {
+            ++Count;
+        }
+        Builder.Appendf(TEXT("  %-20s %6d\n"), *Class->GetName(), Count);
+    };
+    AppendActorCount(ALaserBeamProjectile::StaticClass());
+    AppendActorCount(ACubeProjectile::StaticClass());
+    AppendActorCount(AMissileProjectile::StaticClass());
+    AppendActorCount(ATankRifleProjectile::StaticClass());
+    AppendActorCount(AGravityFPSTestProjectile::StaticClass());
+
+    const UGameInstance* GameInstance = SampledWorld->GetGameInstance();
+    const UMissileManagerSubsystem* MissileManager = GameInstance ? GameInstance->GetSubsystem<UMissileManagerSubsystem>() : nullptr;
+    Builder.Appendf(TEXT("Missiles active   %6d\n"), MissileManager ? MissileManager->ActiveMissiles.Num() : 0);
+    Builder.Appendf(TEXT("Radar contacts    %6d\n"), FGameplayPerfCounters::RadarContacts);
+
+    const UHUDModelSubsystem* HUDModel = UHUDModelSubsystem::Get(SampledWorld->GetFirstPlayerController());
+    Builder.Appendf(TEXT("Biopad rows       %6d\n"), HUDModel ? HUDModel->GetBiopadRows().Num() : 0);
+
+    int32 NumWidgets = 0;
+    for (TObjectIterator<UUserWidget> It; It; ++It)
+    {
+        if (It->GetWorld() == SampledWorld)
+        {
+            ++NumWidgets;
+        }
+    }
+    Builder.Appendf(TEXT("User widgets      %6d\n"), NumWidgets);
+
+    Builder.Append(TEXT("Scene queries / frame"));
+    FGameplayPerfCounters::SceneQueries.ValueSort(TGreater<int32>());
+    for (TPair<FName, int32>& Query : FGameplayPerfCounters::SceneQueries)
+    {
+        Builder.Appendf(TEXT("\n  %-20s %6.1f"), *Query.Key.ToString(), Query.Value / Frames);
+        Query.Value = 0;
+    }
+
+    Text = FText::FromStringView(Builder.ToView());
+    return EActiveTimerReturnType::Continue;
+}
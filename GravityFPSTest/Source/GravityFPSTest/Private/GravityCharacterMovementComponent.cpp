@@ -0,0 +1,187 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "GravityCharacterMovementComponent.h"
+#include "GameFramework/Character.h"
+#include "Constants.h"
+
+void UGravityCharacterMovementComponent::StartThrusting(float YawSinceLastFlight)
+{
+    // no jump to get off the ground first, the thrusting mode doesn't stick to the floor the way walking does
+    if (!FlyingVelocity.IsNearlyZero())
+    {
+        FlyingVelocity = FRotator(0.0f, YawSinceLastFlight, 0.0f).RotateVector(FlyingVelocity);
+    }
+    if (!IsThrusting())
+    {
+        SetMovementMode(MOVE_Custom, static_cast<uint8>(EGravityMovementMode::Thrusting));
+    }
+}
+
+void UGravityCharacterMovementComponent::StopThrusting()
+{
+    if (IsThrusting())
+    {
+        SetMovementMode(MOVE_Falling);
+    }
+}
+
+void UGravityCharacterMovementComponent::StartWallRun(const FVector& InWallNormal)
+{
+    WallNormal = InWallNormal;
+    if (!IsWallRunning())
+    {
+        SetMovementMode(MOVE_Custom, static_cast<uint8>(EGravityMovementMode::WallRun));
+    }
+}
+
+void UGravityCharacterMovementComponent::StopWallRun()
+{
+    if (IsWallRunning())
+    {
+        SetMovementMode(MOVE_Falling);
+    }
+}
+
+void UGravityCharacterMovementComponent::TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+    bImpactThisUpdate = false;
+    Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+    // the floor is only kept up to date while walking, anything else we touched was reported through HandleImpact during the move
+    bTouchingSurface = bImpactThisUpdate || (IsMovingOnGround() && CurrentFloor.IsWalkableFloor());
+}
+
+void UGravityCharacterMovementComponent::HandleImpact(const FHitResult& Hit, float TimeSlice, const FVector& MoveDelta)
+{
+    Super::HandleImpact(Hit, TimeSlice, MoveDelta);
+    bImpactThisUpdate = true;
+}
+
+float UGravityCharacterMovementComponent::GetMaxSpeed() const
+{
+    // wall running used to be falling, which is capped at the walk speed the human's momentum drives, not the custom movement speed
+    if (IsWallRunning())
+    {
+        return MaxWalkSpeed;
+    }
+    return Super::GetMaxSpeed();
+}
+
+void UGravityCharacterMovementComponent::PhysCustom(float deltaTime, int32 Iterations)
+{
+    switch (static_cast<EGravityMovementMode>(CustomMovementMode))
+    {
+    case EGravityMovementMode::Thrusting:
+        PhysThrusting(deltaTime, Iterations);
+        break;
+    case EGravityMovementMode::WallRun:
+        PhysWallRun(deltaTime, Iterations);
+        break;
+    default:
+        Super::PhysCustom(deltaTime, Iterations);
+        break;
+    }
+}
+
+/// <summary>
+/// PhysThrusting moves the player while the thrusters are on. There is no gravity, the flying velocity accelerates towards the thrust input
+/// up to the maximum flying speed, and the move slides along anything it runs into. The flying velocity itself is not changed by collisions,
+/// so the player keeps their momentum once they clear whatever they hit.
+/// </summary>
+/// <param>Takes the time to simulate and how many iterations have already been used this frame</param>
+/// <returns>return type is void</returns>
+void UGravityCharacterMovementComponent::PhysThrusting(float deltaTime, int32 Iterations)
+{
+    float RemainingTime = deltaTime;
+    while (RemainingTime >= MIN_TICK_TIME && Iterations < MaxSimulationIterations && CharacterOwner)
+    {
+        Iterations++;
+        bJustTeleported = false;
+        const float TimeTick = GetSimulationTimeStep(RemainingTime, Iterations);
+        RemainingTime -= TimeTick;
+
+        FlyingVelocity += ThrustInput.GetSafeNormal() * Constants::c_ThrustAccel * TimeTick;
+        FlyingVelocity = FlyingVelocity.GetClampedToMaxSize(Constants::c_MaxFlyingSpeed);
+        Velocity = FlyingVelocity;
+
+        const FVector OldLocation = UpdatedComponent->GetComponentLocation();
+        const FVector Delta = Velocity * TimeTick;
+        FHitResult Hit(1.0f);
+        SafeMoveUpdatedComponent(Delta, UpdatedComponent->GetComponentQuat(), true, Hit);
+        if (Hit.Time < 1.0f)
+        {
+            HandleImpact(Hit, TimeTick, Delta);
+            SlideAlongSurface(Delta, 1.0f - Hit.Time, Hit.Normal, Hit, true);
+        }
+
+        if (!bJustTeleported && TimeTick > 0.0f)
+        {
+            Velocity = (UpdatedComponent->GetComponentLocation() - OldLocation) / TimeTick;
+        }
+
+        // the move may have changed our mode (e.g. something stopped the thrusters), let that mode use up the rest of the time
+        if (!IsThrusting())
+        {
+            StartNewPhysics(RemainingTime, Iterations);
+            return;
+        }
+    }
+}
+
+/// <summary>
+/// PhysWallRun moves the player along a wall they are running on. It is falling with reduced gravity, with the velocity kept in the plane of
+/// the wall so the player neither drifts off it nor pushes into it. Landing on something walkable ends the wall run.
+/// </summary>
+/// <param>Takes the time to simulate and how many iterations have already been used this frame</param>
+/// <returns>return type is void</returns>
+void UGravityCharacterMovementComponent::PhysWallRun(float deltaTime, int32 Iterations)
+{
+    float RemainingTime = deltaTime;
+    while (RemainingTime >= MIN_TICK_TIME && Iterations < MaxSimulationIterations && CharacterOwner)
+    {
+        Iterations++;
+        bJustTeleported = false;
+        const float TimeTick = GetSimulationTimeStep(RemainingTime, Iterations);
+        RemainingTime -= TimeTick;
+
+        // lateral movement works like air control while falling (same acceleration, friction and braking), gravity is only a fraction of the usual
+        const float VerticalSpeed = Velocity.Z;
+        {
+            FVector LateralAcceleration = GetFallingLateralAcceleration(TimeTick);
+            LateralAcceleration.Z = 0.0f;
+            TGuardValue<FVector> RestoreAcceleration(Acceleration, LateralAcceleration);
+            Velocity.Z = 0.0f;
+            CalcVelocity(TimeTick, FallingLateralFriction, false, BrakingDecelerationFalling);
+        }
+        Velocity.Z = VerticalSpeed + UMovementComponent::GetGravityZ() * Constants::c_WallGravity * TimeTick;
+        Velocity = FVector::VectorPlaneProject(Velocity, WallNormal);
+
+        const FVector OldLocation = UpdatedComponent->GetComponentLocation();
+        const FVector Delta = Velocity * TimeTick;
+        FHitResult Hit(1.0f);
+        SafeMoveUpdatedComponent(Delta, UpdatedComponent->GetComponentQuat(), true, Hit);
+        if (Hit.IsValidBlockingHit())
+        {
+            if (IsValidLandingSpot(UpdatedComponent->GetComponentLocation(), Hit))
+            {
+                RemainingTime += TimeTick * (1.0f - Hit.Time);
+                ProcessLanded(Hit, RemainingTime, Iterations);
+                return;
+            }
+            HandleImpact(Hit, TimeTick, Delta);
+            SlideAlongSurface(Delta, 1.0f - Hit.Time, Hit.Normal, Hit, true);
+        }
+
+        if (!bJustTeleported && TimeTick > 0.0f)
+        {
+            Velocity = (UpdatedComponent->GetComponentLocation() - OldLocation) / TimeTick;
+        }
+
+        if (!IsWallRunning())
+        {
+            StartNewPhysics(RemainingTime, Iterations);
+            return;
+        }
+    }
+}
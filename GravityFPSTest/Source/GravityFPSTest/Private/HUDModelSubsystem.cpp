@@ -0,0 +1,103 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "HUDModelSubsystem.h"
+#include "Engine/LocalPlayer.h"
+#include "GameFramework/PlayerController.h"
+#include "GravityFPSTest/GravityFPSTestCharacter.h"
+
+UHUDModelSubsystem* UHUDModelSubsystem::Get(const AController* Controller)
+{
+    const APlayerController* PlayerController = Cast<APlayerController>(Controller);
+    ULocalPlayer* LocalPlayer = PlayerController ? PlayerController->GetLocalPlayer() : nullptr;
+    return LocalPlayer ? LocalPlayer->GetSubsystem<UHUDModelSubsystem>() : nullptr;
+}
+
+void UHUDModelSubsystem::SetFuelPercent(float Percent)
+{
+    Percent = FMath::Clamp(Percent, 0.0f, 1.0f);
+    // a tenth of a percent is well under a pixel on the fuel bar
+    if (FMath::IsNearlyEqual(Percent, FuelPercent, 0.001f))
+    {
+        return;
+    }
+    FuelPercent = Percent;
+    OnFuelChanged.Broadcast(FuelPercent);
+}
+
+void UHUDModelSubsystem::SetInvisibilityTimeRemaining(float Seconds)
+{
+    // the countdown is shown in whole seconds, rounded up so it reads 0:01 until it actually runs out
+    const int32 WholeSeconds = FMath::Max(FMath::FloorToInt32(Seconds) + 1, 0);
+    if (WholeSeconds == InvisibilitySecondsRemaining)
+    {
+        return;
+    }
+    InvisibilitySecondsRemaining = WholeSeconds;
+    OnInvisibilityChanged.Broadcast(InvisibilitySecondsRemaining);
+}
+
+void UHUDModelSubsystem::SetEquipment(FName NewEquipment)
+{
+    // always broadcast, the icon flashes up again even when the same equipment is picked
+    Equipment = NewEquipment;
+    OnEquipmentChanged.Broadcast(Equipment);
+}
+
+void UHUDModelSubsystem::RefreshBiopadRows()
+{
+    ULocalPlayer* LocalPlayer = GetLocalPlayer();
+    APlayerController* PlayerController = LocalPlayer ? LocalPlayer->PlayerController : nullptr;
+    AGravityFPSTestCharacter* Character = PlayerController ? Cast<AGravityFPSTestCharacter>(PlayerController->GetPawn()) : nullptr;
+    UBiopadComponent* Biopad = Character ? Character->GetBiopadComponent() : nullptr;
+    if (!Biopad)
+    {
+        return;
+    }
+
+    // the rows are built here if anything moved, the version says whether they were
+    const TArray<FActorInfoDisplay>& Rows = Biopad->GetActorDisplayData();
+    if (BiopadSource == Biopad && BiopadRowsVersion == Biopad->GetDisplayDataVersion())
+    {
+        return;
+    }
+    BiopadSource = Biopad;
+    BiopadRowsVersion = Biopad->GetDisplayDataVersion();
+    SetBiopadRows(Rows);
+}
+
+/// <summary>SetBiopadRows stores the biopad rows and lets the biopad widget know if any of them changed in a way it would display, meaning a
+/// different actor or a distance that rounds to a different whole unit. The stored rows are updated in place, only names that differ are copied
+/// and those reuse the existing string buffers, so a change in distance alone allocates nothing.</summary>
+/// <param>Takes the rows to display, in display order</param>
+/// <returns>return type is void</returns>
+void UHUDModelSubsystem::SetBiopadRows(const TArray<FActorInfoDisplay>& Rows)
+{
+    auto Rounded = [](const FVector& Distance)
+    {
+        return FIntVector(FMath::RoundToInt(Distance.X), FMath::RoundToInt(Distance.Y), FMath::RoundToInt(Distance.Z));
+    };
+
+    bool bChanged = Rows.Num() != BiopadRows.Num();
+    for (int32 i = 0; !bChanged && i < Rows.Num(); ++i)
+    {
+        bChanged = Rows[i].Name != BiopadRows[i].Name
+            || Rounded(Rows[i].Distance) != Rounded(BiopadRows[i].Distance)
+            || FMath::RoundToInt(Rows[i].Distance.Length()) != FMath::RoundToInt(BiopadRows[i].Distance.Length());
+    }
+    if (!bChanged)
+    {
+        return;
+    }
+
+    BiopadRows.SetNum(Rows.Num(), false);
+    for (int32 i = 0; i < Rows.Num(); ++i)
+    {
+        if (BiopadRows[i].Name != Rows[i].Name)
+        {
+            BiopadRows[i].Name = Rows[i].Name;
+        }
+        BiopadRows[i].Distance = Rows[i].Distance;
+    }
+    OnBiopadRowsChanged.Broadcast(BiopadRows);
+}
@@ -0,0 +1,137 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "HUDUserWidget.h"
+#include "HUDModelSubsystem.h"
+#include "Blueprint/WidgetTree.h"
+#include "Engine/LocalPlayer.h"
+#include "Widgets/SInvalidationPanel.h"
+
+void UHUDUserWidget::SetVisibility(ESlateVisibility InVisibility)
+{
+    Super::SetVisibility(InVisibility);
+    RefreshHUDSuspension();
+}
+
+void UHUDUserWidget::NativeConstruct()
+{
+    Super::NativeConstruct();
+    RefreshHUDSuspension();
+}
+
+void UHUDUserWidget::NativeDestruct()
+{
+    if (UWorld* World = GetWorld())
+    {
+        for (FTimerHandle* Handle : HUDTimers)
+        {
+            World->GetTimerManager().ClearTimer(*Handle);
+        }
+    }
+    HUDTimers.Reset();
+    Super::NativeDestruct();
+}
+
+TSharedRef<SWidget> UHUDUserWidget::RebuildWidget()
+{
+    TSharedRef<SWidget> Content = Super::RebuildWidget();
+    if (!bCacheWithInvalidationPanel)
+    {
+        return Content;
+    }
+    return SNew(SInvalidationPanel)
+        [
+            Content
+        ];
+}
+
+UHUDModelSubsystem* UHUDUserWidget::GetHUDModel() const
+{
+    ULocalPlayer* LocalPlayer = GetOwningLocalPlayer();
+    return LocalPlayer ? LocalPlayer->GetSubsystem<UHUDModelSubsystem>() : nullptr;
+}
+
+void UHUDUserWidget::RegisterHUDTimer(FTimerHandle& Handle)
+{
+    HUDTimers.AddUnique(&Handle);
+    ApplyHUDTimerState();
+}
+
+void UHUDUserWidget::ApplyHUDTimerState()
+{
+    UWorld* World = GetWorld();
+    if (!World)
+    {
+        return;
+    }
+    FTimerManager& TimerManager = World->GetTimerManager();
+    for (FTimerHandle* Handle : HUDTimers)
+    {
+        if (bHUDSuspended)
+        {
+            TimerManager.PauseTimer(*Handle);
+        }
+        else
+        {
+            TimerManager.UnPauseTimer(*Handle);
+        }
+    }
+}
+
+void UHUDUserWidget::SetHUDTickWanted(bool bWanted)
+{
+    // always applied, the Slate widget may have been rebuilt (and able to tick again) since the last call
+    bHUDTickWanted = bWanted;
+    ApplyHUDTickState();
+}
+
+void UHUDUserWidget::ApplyHUDTickState()
+{
+    if (TSharedPtr<SWidget> SafeWidget = GetCachedWidget())
+    {
+        SafeWidget->SetCanTick(bHUDTickWanted && !bHUDSuspended);
+    }
+}
+
+void UHUDUserWidget::SetParentSuspended(bool bSuspended)
+{
+    bParentSuspended = bSuspended;
+    RefreshHUDSuspension();
+}
+
+/// <summary>RefreshHUDSuspension works out whether the widget can currently be seen and, if that changed, pauses or resumes its timers and
+/// ticking and passes the new state down to any HUD widgets nested inside it.</summary>
+/// <returns>return type is void</returns>
+void UHUDUserWidget::RefreshHUDSuspension()
+{
+    const ESlateVisibility CurrentVisibility = GetVisibility();
+    const bool bShouldSuspend = bParentSuspended || CurrentVisibility == ESlateVisibility::Hidden || CurrentVisibility == ESlateVisibility::Collapsed;
+    if (bShouldSuspend == bHUDSuspended)
+    {
+        return;
+    }
+    bHUDSuspended = bShouldSuspend;
+
+    ApplyHUDTimerState();
+    ApplyHUDTickState();
+
+    if (WidgetTree)
+    {
+        WidgetTree->ForEachWidget([this](UWidget* Widget)
+        {
+            if (UHUDUserWidget* NestedWidget = Cast<UHUDUserWidget>(Widget))
+            {
+                NestedWidget->SetParentSuspended(bHUDSuspended);
+            }
+        });
+    }
+
+    if (bHUDSuspended)
+    {
+        OnHUDSuspended();
+    }
+    else
+    {
+        OnHUDResumed();
+    }
+}
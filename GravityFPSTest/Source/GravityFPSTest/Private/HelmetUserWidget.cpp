@@ -8,15 +8,13 @@ bool UHelmetUserWidget::Initialize()
 	bool bResult = Super::Initialize();
 	pct = 0.0f;
 	helmetState = EHelmetState::Hidden;
-	UWidget* HelmetImage = GetWidgetFromName(TEXT("HelmetImage"));
-	UWidget* HelmetScreen = GetWidgetFromName(TEXT("HelmetImageOpacity"));
 	if (HelmetImage)
 	{
 		HelmetImage->SetRenderOpacity(0.0f);
 	}
-	if (HelmetScreen)
+	if (HelmetImageOpacity)
 	{
-		HelmetScreen->SetRenderOpacity(0.0f);
+		HelmetImageOpacity->SetRenderOpacity(0.0f);
 	}
 
 	if (!bResult)
@@ -39,16 +37,15 @@ void UHelmetUserWidget::NativeTick(const FGeometry& MyGeometry, float InDeltaTim
 		{
 			pct -= InDeltaTime;
 		}
+		pct = FMath::Clamp(pct, 0.0f, 1.0f);
 		float LerpedValue = FMath::Lerp(0.0f, 1.0f, pct);
-		UWidget* HelmetImage = GetWidgetFromName(TEXT("HelmetImage"));
-		UWidget* HelmetScreen = GetWidgetFromName(TEXT("HelmetImageOpacity"));
 		if (HelmetImage)
 		{
 			HelmetImage->SetRenderOpacity(LerpedValue);
 		}
-		if (HelmetScreen)
+		if (HelmetImageOpacity)
 		{
-			HelmetScreen->SetRenderOpacity(LerpedValue/4.0f);
+			HelmetImageOpacity->SetRenderOpacity(LerpedValue/4.0f);
 		}
 		if (pct >= 1.0f)
 		{
@@ -59,14 +56,22 @@ void UHelmetUserWidget::NativeTick(const FGeometry& MyGeometry, float InDeltaTim
 			helmetState = EHelmetState::Hidden;
 		}
 	}
+
+	// nothing changes until the next fade, so stop ticking until then
+	if (helmetState == EHelmetState::Visible || helmetState == EHelmetState::Hidden)
+	{
+		SetHUDTickWanted(false);
+	}
 }
 
 void UHelmetUserWidget::PlayFadeIn()
 {
 	helmetState = EHelmetState::FadingIn;
+	SetHUDTickWanted(true);
 }
 
 void UHelmetUserWidget::PlayFadeOut()
 {
 	helmetState = EHelmetState::FadingOut;
-}
\ No newline at end of file
+	SetHUDTickWanted(true);
+}
@@ -3,13 +3,16 @@
 
 #include "IconsUserWidget.h"
 #include "Components/Image.h"
+#include "Engine/Texture2D.h"
 #include "Constants.h"
+#include "HUDModelSubsystem.h"
 
 
 bool UIconsUserWidget::Initialize()
 {
     bool bResult = Super::Initialize();
     pct = 0.0f;
+    BrushToDisplay = nullptr;
     SetRenderOpacity(pct);
     if (!bResult)
     {
@@ -18,9 +21,28 @@ bool UIconsUserWidget::Initialize()
     return true;
 }
 
+void UIconsUserWidget::NativeConstruct()
+{
+    Super::NativeConstruct();
+    BuildIconBrushes();
+    if (UHUDModelSubsystem* HUDModel = GetHUDModel())
+    {
+        HUDModel->OnEquipmentChanged.AddUObject(this, &UIconsUserWidget::SetDisplayLabel);
+    }
+}
+
+void UIconsUserWidget::NativeDestruct()
+{
+    if (UHUDModelSubsystem* HUDModel = GetHUDModel())
+    {
+        HUDModel->OnEquipmentChanged.RemoveAll(this);
+    }
+    Super::NativeDestruct();
+}
+
 void UIconsUserWidget::NativeTick(const FGeometry& MyGeometry, float InDeltaTime)
 {
-    if (IconToDisplay && pct > 0.0f)
+    if (BrushToDisplay && pct > 0.0f)
     {
         pct -= InDeltaTime;
         float LerpedValue = FMath::Lerp(0.0f, 1.0f, pct);
@@ -28,21 +50,56 @@ void UIconsUserWidget::NativeTick(const FGeometry& MyGeometry, float InDeltaTime
     }
 }
 
+/// <summary>
+/// BuildIconBrushes makes the brush for every equipment icon up front, either as a region of the icon atlas or from the icon's own texture.
+/// The textures are hard references of this widget, which is created at startup, so they are resident before the first equipment change.
+/// </summary>
+/// <returns>return type is void</returns>
+void UIconsUserWidget::BuildIconBrushes()
+{
+    IconBrushes.Reset();
+    BrushToDisplay = nullptr;
+
+    if (EquipmentIconAtlas)
+    {
+        const FVector2D AtlasSize(EquipmentIconAtlas->GetSizeX(), EquipmentIconAtlas->GetSizeY());
+        for (const TPair<FName, FBox2D>& Region : EquipmentIconRegions)
+        {
+            FSlateBrush& Brush = IconBrushes.Add(Region.Key);
+            Brush.SetResourceObject(EquipmentIconAtlas);
+            Brush.SetUVRegion(FBox2f(FVector2f(Region.Value.Min), FVector2f(Region.Value.Max)));
+            Brush.ImageSize = AtlasSize * Region.Value.GetSize();
+        }
+        return;
+    }
+
+    for (const TPair<FName, UTexture2D*>& Icon : EquipmentIcons)
+    {
+        if (!Icon.Value)
+        {
+            continue;
+        }
+        FSlateBrush& Brush = IconBrushes.Add(Icon.Key);
+        Brush.SetResourceObject(Icon.Value);
+        Brush.ImageSize = FVector2D(Icon.Value->GetSizeX(), Icon.Value->GetSizeY());
+    }
+}
+
 void UIconsUserWidget::SetDisplayLabel(FName name)
 {
-    UTexture2D* FoundIcon = EquipmentIcons.FindRef(name);
-    if (!FoundIcon)
+    const FSlateBrush* FoundBrush = IconBrushes.Find(name);
+    if (!FoundBrush)
     {
         UE_LOG(LogTemp, Warning, TEXT("No icon found for %s"), *name.ToString());
         return;
     }
 
-    IconToDisplay = FoundIcon;
     pct = 1.0f;
 
-    // Actually update the image brush
-    if (EquipmentImage && IconToDisplay)
-    { 
-        EquipmentImage->SetBrushFromTexture(IconToDisplay, true);
+    // the brush only changes when the equipment does, picking the same thing again just flashes the icon up
+    if (EquipmentImage && BrushToDisplay != FoundBrush)
+    {
+        EquipmentImage->SetBrush(*FoundBrush);
     }
+    BrushToDisplay = FoundBrush;
 }
\ No newline at end of file
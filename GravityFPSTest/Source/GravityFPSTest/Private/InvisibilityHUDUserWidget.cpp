@@ -3,8 +3,7 @@
 
 #include "InvisibilityHUDUserWidget.h"
 #include "Components/TextBlock.h"
-#include "Kismet/GameplayStatics.h"
-#include "GravityFPSTest/GravityFPSTestCharacter.h"
+#include "HUDModelSubsystem.h"
 
 bool UInvisibilityHUDUserWidget::Initialize()
 {
@@ -13,38 +12,39 @@ bool UInvisibilityHUDUserWidget::Initialize()
     {
         return false;
     }
-    UTextBlock* Widget = Cast<UTextBlock>(GetWidgetFromName("CountDownText"));
-    if (Widget != nullptr)
+    if (CountDownText)
     {
-        Widget->SetText(FText::FromString("00:00"));
+        CountDownText->SetText(FText::FromString("00:00"));
     }
     return true;
 }
 
-void UInvisibilityHUDUserWidget::NativeTick(const FGeometry& MyGeometry, float InDeltaTime)
+void UInvisibilityHUDUserWidget::NativeConstruct()
 {
-    Super::NativeTick(MyGeometry, InDeltaTime);
-    DisplayCountDown();
+    Super::NativeConstruct();
+    if (UHUDModelSubsystem* HUDModel = GetHUDModel())
+    {
+        DisplayCountDown(HUDModel->GetInvisibilitySecondsRemaining());
+        HUDModel->OnInvisibilityChanged.AddUObject(this, &UInvisibilityHUDUserWidget::DisplayCountDown);
+    }
 }
 
-void UInvisibilityHUDUserWidget::DisplayCountDown()
+void UInvisibilityHUDUserWidget::NativeDestruct()
 {
-    UTextBlock* Widget = Cast<UTextBlock>(GetWidgetFromName("CountDownText"));
-    AController* pController = UGameplayStatics::GetPlayerController(GetWorld(), 0);
-    APawn* Pawn = pController->GetPawn();
-    AGravityFPSTestCharacter* pPlayerCharacter = Cast<AGravityFPSTestCharacter>(Pawn);
-
-    // GetInvisibilityCountDownDuration returns the countdown in seconds, but we want to display it to the user as a clock in minutes and seconds.
-    // We add 1.0f to offset the rounding error.
-    float CurrentTimeInSeconds = pPlayerCharacter->GetInvisibilityCountDownDuration() + 1.0f;
-    int CurrentTimeInMinutes = 0;
+    if (UHUDModelSubsystem* HUDModel = GetHUDModel())
+    {
+        HUDModel->OnInvisibilityChanged.RemoveAll(this);
+    }
+    Super::NativeDestruct();
+}
 
-    // Convert extra seconds into minutes.
-    while (CurrentTimeInSeconds >= 60.0f)
+void UInvisibilityHUDUserWidget::DisplayCountDown(int32 SecondsRemaining)
+{
+    if (!CountDownText)
     {
-        CurrentTimeInSeconds -= 60.0f;
-        CurrentTimeInMinutes += 1;
+        return;
     }
 
-    Widget->SetText(FText::FromString(FString::Printf(TEXT("%2d:%02d"), CurrentTimeInMinutes, (int)CurrentTimeInSeconds)));
+    // The countdown is published in whole seconds, but we want to display it to the user as a clock in minutes and seconds.
+    CountDownText->SetText(FText::FromString(FString::Printf(TEXT("%2d:%02d"), SecondsRemaining / 60, SecondsRemaining % 60)));
 }
\ No newline at end of file
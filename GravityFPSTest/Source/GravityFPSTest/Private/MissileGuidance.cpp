@@ -0,0 +1,200 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "MissileGuidance.h"
+#include "MissileProjectile.h"
+#include "GameFramework/ProjectileMovementComponent.h"
+#include "Constants.h"
+
+void FMissileGuidanceBatch::Reset(int32 Capacity)
+{
+    Num = 0;
+    const int32 Padded = Align(Capacity, 4);
+    for (TArray<float>* Array : { &VelX, &VelY, &VelZ, &OffsetX, &OffsetY, &OffsetZ, &TargetVelX, &TargetVelY, &TargetVelZ })
+    {
+        Array->Reset(Padded);
+    }
+    Missiles.Reset(Capacity);
+}
+
+void FMissileGuidanceBatch::Add(AMissileProjectile* Missile, const FVector& Position, const FVector& Velocity, const FVector& TargetPosition, const FVector& TargetVelocity)
+{
+    // subtract in double first, only the (small) offset is narrowed to float
+    const FVector Offset = TargetPosition - Position;
+    VelX.Add(Velocity.X);
+    VelY.Add(Velocity.Y);
+    VelZ.Add(Velocity.Z);
+    OffsetX.Add(Offset.X);
+    OffsetY.Add(Offset.Y);
+    OffsetZ.Add(Offset.Z);
+    TargetVelX.Add(TargetVelocity.X);
+    TargetVelY.Add(TargetVelocity.Y);
+    TargetVelZ.Add(TargetVelocity.Z);
+    Missiles.Add(Missile);
+    ++Num;
+}
+
+void FMissileGuidanceBatch::Pad()
+{
+    // zero filled lanes produce finite (and ignored) results in the kernel
+    const int32 Padded = Align(Num, 4);
+    for (TArray<float>* Array : { &VelX, &VelY, &VelZ, &OffsetX, &OffsetY, &OffsetZ, &TargetVelX, &TargetVelY, &TargetVelZ })
+    {
+        Array->SetNumZeroed(Padded);
+    }
+}
+
+void UMissileGuidanceSubsystem::RegisterMissile(AMissileProjectile* Missile)
+{
+    if (Missile && Missile->GuidanceIndex == INDEX_NONE)
+    {
+        Missile->GuidanceIndex = GuidedMissiles.Add(Missile);
+    }
+}
+
+void UMissileGuidanceSubsystem::UnregisterMissile(AMissileProjectile* Missile)
+{
+    if (!Missile || !GuidedMissiles.IsValidIndex(Missile->GuidanceIndex))
+    {
+        return;
+    }
+    const int32 Index = Missile->GuidanceIndex;
+    GuidedMissiles.RemoveAtSwap(Index, 1, false);
+    if (GuidedMissiles.IsValidIndex(Index))
+    {
+        GuidedMissiles[Index]->GuidanceIndex = Index;
+    }
+    Missile->GuidanceIndex = INDEX_NONE;
+}
+
+void UMissileGuidanceSubsystem::Tick(float DeltaTime)
+{
+    Super::Tick(DeltaTime);
+    if (GuidedMissiles.IsEmpty() || DeltaTime <= 0.0f)
+    {
+        return;
+    }
+
+    GatherBatch();
+    if (Batch.Num > 0)
+    {
+        ComputeSteering(DeltaTime);
+        WriteBackVelocities();
+    }
+}
+
+void UMissileGuidanceSubsystem::GatherBatch()
+{
+    Batch.Reset(GuidedMissiles.Num());
+    for (AMissileProjectile* Missile : GuidedMissiles)
+    {
+        AActor* Target = Missile->GetHomingTarget();
+        USceneComponent* TargetComponent = Target ? Target->GetRootComponent() : nullptr;
+        if (!TargetComponent || !Missile->ProjectileMovement)
+        {
+            // missiles without a target just keep flying straight
+            continue;
+        }
+        Batch.Add(Missile, Missile->GetActorLocation(), Missile->ProjectileMovement->Velocity,
+            TargetComponent->GetComponentLocation(), TargetComponent->GetComponentVelocity());
+    }
+    Batch.Pad();
+}
+
+/// <summary>ComputeSteering runs proportional navigation for four missiles at a time. The line of sight is taken to the target's predicted position
+/// (current position plus velocity times time-to-go), and the commanded acceleration is N * (LOS rate x missile velocity). Missiles that are not
+/// closing on their target (e.g. they just launched facing away from it) pursue the predicted point directly instead. The acceleration is clamped and
+/// the missile keeps its current speed, only its direction changes. The new velocity is written back into the Vel arrays.</summary>
+/// <param>Takes a float for the frame's delta time</param>
+/// <returns>return type is void</returns>
+void UMissileGuidanceSubsystem::ComputeSteering(float DeltaTime)
+{
+    const VectorRegister4Float Zero = VectorZeroFloat();
+    const VectorRegister4Float One = VectorOneFloat();
+    const VectorRegister4Float Epsilon = VectorSetFloat1(UE_KINDA_SMALL_NUMBER);
+    const VectorRegister4Float Dt = VectorSetFloat1(DeltaTime);
+    const VectorRegister4Float NavConstant = VectorSetFloat1(Constants::c_MissileNavigationConstant);
+    const VectorRegister4Float PursuitGain = VectorSetFloat1(Constants::c_MissilePursuitGain);
+    const VectorRegister4Float MaxAccel = VectorSetFloat1(Constants::c_MissileMaxGuidanceAccel);
+    const VectorRegister4Float MaxLeadTime = VectorSetFloat1(Constants::c_MissileMaxLeadTime);
+
+    const int32 Padded = Batch.VelX.Num();
+    for (int32 i = 0; i < Padded; i += 4)
+    {
+        const VectorRegister4Float Vx = VectorLoad(&Batch.VelX[i]);
+        const VectorRegister4Float Vy = VectorLoad(&Batch.VelY[i]);
+        const VectorRegister4Float Vz = VectorLoad(&Batch.VelZ[i]);
+        const VectorRegister4Float Tvx = VectorLoad(&Batch.TargetVelX[i]);
+        const VectorRegister4Float Tvy = VectorLoad(&Batch.TargetVelY[i]);
+        const VectorRegister4Float Tvz = VectorLoad(&Batch.TargetVelZ[i]);
+
+        // Relative position and velocity of the target
+        const VectorRegister4Float Rx0 = VectorLoad(&Batch.OffsetX[i]);
+        const VectorRegister4Float Ry0 = VectorLoad(&Batch.OffsetY[i]);
+        const VectorRegister4Float Rz0 = VectorLoad(&Batch.OffsetZ[i]);
+        const VectorRegister4Float Wx = VectorSubtract(Tvx, Vx);
+        const VectorRegister4Float Wy = VectorSubtract(Tvy, Vy);
+        const VectorRegister4Float Wz = VectorSubtract(Tvz, Vz);
+
+        // Closing speed and time-to-go give the lead point
+        const VectorRegister4Float RangeSq0 = VectorMax(VectorMultiplyAdd(Rx0, Rx0, VectorMultiplyAdd(Ry0, Ry0, VectorMultiply(Rz0, Rz0))), Epsilon);
+        const VectorRegister4Float InvRange0 = VectorReciprocalSqrt(RangeSq0);
+        const VectorRegister4Float ClosingSpeed = VectorNegate(VectorMultiply(VectorMultiplyAdd(Rx0, Wx, VectorMultiplyAdd(Ry0, Wy, VectorMultiply(Rz0, Wz))), InvRange0));
+        const VectorRegister4Float TimeToGo = VectorMin(VectorDivide(VectorMultiply(RangeSq0, InvRange0), VectorMax(ClosingSpeed, Epsilon)), MaxLeadTime);
+
+        const VectorRegister4Float Rx = VectorMultiplyAdd(Tvx, TimeToGo, Rx0);
+        const VectorRegister4Float Ry = VectorMultiplyAdd(Tvy, TimeToGo, Ry0);
+        const VectorRegister4Float Rz = VectorMultiplyAdd(Tvz, TimeToGo, Rz0);
+        const VectorRegister4Float RangeSq = VectorMax(VectorMultiplyAdd(Rx, Rx, VectorMultiplyAdd(Ry, Ry, VectorMultiply(Rz, Rz))), Epsilon);
+        const VectorRegister4Float InvRangeSq = VectorDivide(One, RangeSq);
+        const VectorRegister4Float InvRange = VectorReciprocalSqrt(RangeSq);
+
+        // Line of sight rate: (R x W) / |R|^2
+        const VectorRegister4Float Ox = VectorMultiply(VectorSubtract(VectorMultiply(Ry, Wz), VectorMultiply(Rz, Wy)), InvRangeSq);
+        const VectorRegister4Float Oy = VectorMultiply(VectorSubtract(VectorMultiply(Rz, Wx), VectorMultiply(Rx, Wz)), InvRangeSq);
+        const VectorRegister4Float Oz = VectorMultiply(VectorSubtract(VectorMultiply(Rx, Wy), VectorMultiply(Ry, Wx)), InvRangeSq);
+
+        // Proportional navigation: N * (Omega x V)
+        const VectorRegister4Float PNx = VectorMultiply(NavConstant, VectorSubtract(VectorMultiply(Oy, Vz), VectorMultiply(Oz, Vy)));
+        const VectorRegister4Float PNy = VectorMultiply(NavConstant, VectorSubtract(VectorMultiply(Oz, Vx), VectorMultiply(Ox, Vz)));
+        const VectorRegister4Float PNz = VectorMultiply(NavConstant, VectorSubtract(VectorMultiply(Ox, Vy), VectorMultiply(Oy, Vx)));
+
+        // Pursuit of the lead point for missiles that are not closing
+        const VectorRegister4Float Speed = VectorSqrt(VectorMultiplyAdd(Vx, Vx, VectorMultiplyAdd(Vy, Vy, VectorMultiply(Vz, Vz))));
+        const VectorRegister4Float DesiredScale = VectorMultiply(Speed, InvRange);
+        const VectorRegister4Float PUx = VectorMultiply(PursuitGain, VectorSubtract(VectorMultiply(Rx, DesiredScale), Vx));
+        const VectorRegister4Float PUy = VectorMultiply(PursuitGain, VectorSubtract(VectorMultiply(Ry, DesiredScale), Vy));
+        const VectorRegister4Float PUz = VectorMultiply(PursuitGain, VectorSubtract(VectorMultiply(Rz, DesiredScale), Vz));
+
+        const VectorRegister4Float bClosing = VectorCompareGT(ClosingSpeed, Zero);
+        VectorRegister4Float Ax = VectorSelect(bClosing, PNx, PUx);
+        VectorRegister4Float Ay = VectorSelect(bClosing, PNy, PUy);
+        VectorRegister4Float Az = VectorSelect(bClosing, PNz, PUz);
+
+        // Clamp the commanded acceleration
+        const VectorRegister4Float AccelSq = VectorMax(VectorMultiplyAdd(Ax, Ax, VectorMultiplyAdd(Ay, Ay, VectorMultiply(Az, Az))), Epsilon);
+        const VectorRegister4Float AccelScale = VectorMin(One, VectorMultiply(MaxAccel, VectorReciprocalSqrt(AccelSq)));
+        Ax = VectorMultiply(Ax, AccelScale);
+        Ay = VectorMultiply(Ay, AccelScale);
+        Az = VectorMultiply(Az, AccelScale);
+
+        // Integrate, then restore the missile's speed so guidance only turns it
+        const VectorRegister4Float Nx = VectorMultiplyAdd(Ax, Dt, Vx);
+        const VectorRegister4Float Ny = VectorMultiplyAdd(Ay, Dt, Vy);
+        const VectorRegister4Float Nz = VectorMultiplyAdd(Az, Dt, Vz);
+        const VectorRegister4Float NewSpeedSq = VectorMax(VectorMultiplyAdd(Nx, Nx, VectorMultiplyAdd(Ny, Ny, VectorMultiply(Nz, Nz))), Epsilon);
+        const VectorRegister4Float SpeedScale = VectorMultiply(Speed, VectorReciprocalSqrt(NewSpeedSq));
+
+        VectorStore(VectorMultiply(Nx, SpeedScale), &Batch.VelX[i]);
+        VectorStore(VectorMultiply(Ny, SpeedScale), &Batch.VelY[i]);
+        VectorStore(VectorMultiply(Nz, SpeedScale), &Batch.VelZ[i]);
+    }
+}
+
+void UMissileGuidanceSubsystem::WriteBackVelocities()
+{
+    for (int32 i = 0; i < Batch.Num; ++i)
+    {
+        Batch.Missiles[i]->ProjectileMovement->Velocity = FVector(Batch.VelX[i], Batch.VelY[i], Batch.VelZ[i]);
+    }
+}
@@ -1,4 +1,280 @@
 // Fill out your copyright notice in the Description page of Project Settings.
 
 
-#include "MissileManager.h"
\ No newline at end of file
+#include "MissileManager.h"
+#include "Constants.h"
+#include "UTargetableInterface.h"
+#include "ClosestActorUtils.h"
+#include "GravityFPSTest/GravityFPSTestCharacter.h"
+
+void UMissileManagerSubsystem::RegisterMissile(AMissileProjectile* Missile)
+{
+    if (!Missile || Missile->ManagerHandle != INDEX_NONE)
+    {
+        return;
+    }
+    Missile->ManagerHandle = ActiveMissiles.Add(Missile);
+    // adding to the ignore list is cheap, removing from it is not, so new missiles are appended and dead ones left in place
+    if (!bMissileQueryParamsDirty)
+    {
+        MissileQueryParams.AddIgnoredActor(Missile);
+    }
+}
+
+void UMissileManagerSubsystem::UnregisterMissile(AMissileProjectile* Missile)
+{
+    if (!Missile || !ActiveMissiles.IsValidIndex(Missile->ManagerHandle))
+    {
+        return;
+    }
+    ActiveMissiles.RemoveAt(Missile->ManagerHandle);
+    Missile->ManagerHandle = INDEX_NONE;
+    // the missile stays in the ignore list, ignoring an actor that no longer exists is harmless
+}
+
+const FCollisionQueryParams& UMissileManagerSubsystem::GetMissileQueryParams(const AActor* Player)
+{
+    // dead missiles pile up in the ignore list, compact it once it holds twice as many entries as there are live ones (plus the player)
+    const bool bNeedsCompacting = MissileQueryParams.GetIgnoredActors().Num() > 2 * (ActiveMissiles.Num() + 1);
+    if (bMissileQueryParamsDirty || bNeedsCompacting || QueryParamsPlayer.Get() != Player)
+    {
+        MissileQueryParams.ClearIgnoredActors();
+        MissileQueryParams.AddIgnoredActor(Player);
+        for (const TWeakObjectPtr<AMissileProjectile>& Missile : ActiveMissiles)
+        {
+            if (Missile.IsValid())
+            {
+                MissileQueryParams.AddIgnoredActor(Missile.Get());
+            }
+        }
+        QueryParamsPlayer = Player;
+        bMissileQueryParamsDirty = false;
+    }
+    return MissileQueryParams;
+}
+
+/// <summary>AcquireTarget is called by each missile as it is spawned to pick a target in front of the player. The expensive part of the search
+/// (cone sweep, occlusion traces, render filter and scoring) is only run when the player's view has moved outside the snapshot tolerances, or the
+/// snapshot is too old. Every missile in a volley fired in between reuses the same result, and is handed the next of the top scoring targets in turn,
+/// so a salvo spreads out over several targets instead of all converging on one.</summary>
+/// <param>Takes the player who fired the missile, and the missile itself</param>
+/// <returns>return type is AActor*, the target to home in on, or nullptr if nothing is in sight.</returns>
+AActor* UMissileManagerSubsystem::AcquireTarget(AGravityFPSTestCharacter* Player, AActor* Missile)
+{
+    if (!Player || !Missile || !Player->GetController())
+    {
+        return nullptr;
+    }
+
+    FVector ViewLocation;
+    FRotator ViewRotation;
+    Player->GetController()->GetPlayerViewPoint(ViewLocation, ViewRotation);
+    const FVector ViewForward = ViewRotation.Vector();
+    const float Now = Player->GetWorld()->GetTimeSeconds();
+
+    bool bRefreshed = false;
+    if (!IsSnapshotUsable(Player->GetWorld(), ViewLocation, ViewForward, Now))
+    {
+        RefreshTargetingSnapshot(Player, ViewLocation, ViewForward, Now);
+        bRefreshed = true;
+    }
+
+    if (AActor* Target = TakeLockedTarget())
+    {
+        return Target;
+    }
+    // every locked target has gone since the snapshot was taken, try the rest of what was in sight before querying the scene again
+    if (AActor* Target = FindNextTarget(Missile, nullptr))
+    {
+        return Target;
+    }
+    // only worth a fresh query if there was something to lose, an empty snapshot just means nothing is in sight
+    if (!bRefreshed && !TargetingSnapshot.LockedTargets.IsEmpty())
+    {
+        RefreshTargetingSnapshot(Player, ViewLocation, ViewForward, Now);
+        return TakeLockedTarget();
+    }
+    return nullptr;
+}
+
+AActor* UMissileManagerSubsystem::TakeLockedTarget(const AActor* Skip)
+{
+    const int32 NumLocks = TargetingSnapshot.LockedTargets.Num();
+    for (int32 Attempt = 0; Attempt < NumLocks; ++Attempt)
+    {
+        const int32 Index = TargetingSnapshot.NextLock++ % NumLocks;
+        AActor* Target = TargetingSnapshot.LockedTargets[Index].Get();
+        // targets may have been destroyed since the snapshot was taken
+        if (IsValid(Target) && Target != Skip && Target->GetRootComponent())
+        {
+            return Target;
+        }
+    }
+    return nullptr;
+}
+
+bool UMissileManagerSubsystem::IsSnapshotUsable(const UWorld* World, const FVector& ViewLocation, const FVector& ViewForward, float Now) const
+{
+    if (!TargetingSnapshot.bValid || TargetingSnapshot.World.Get() != World)
+    {
+        return false;
+    }
+    if (Now < TargetingSnapshot.TimeStamp || Now - TargetingSnapshot.TimeStamp > Constants::c_TargetSnapshotTimeToLive)
+    {
+        return false;
+    }
+    if (FVector::DistSquared(ViewLocation, TargetingSnapshot.ViewLocation) > FMath::Square(Constants::c_TargetSnapshotPositionTolerance))
+    {
+        return false;
+    }
+    const float CosAngleTolerance = FMath::Cos(FMath::DegreesToRadians(Constants::c_TargetSnapshotAngleTolerance));
+    return FVector::DotProduct(ViewForward, TargetingSnapshot.ViewForward) >= CosAngleTolerance;
+}
+
+void UMissileManagerSubsystem::RefreshTargetingSnapshot(AGravityFPSTestCharacter* Player, const FVector& ViewLocation, const FVector& ViewForward, float Now)
+{
+    TargetingSnapshot.ViewLocation = ViewLocation;
+    TargetingSnapshot.ViewForward = ViewForward;
+    TargetingSnapshot.TimeStamp = Now;
+    TargetingSnapshot.World = Player->GetWorld();
+    TargetingSnapshot.bValid = true;
+    TargetingSnapshot.Candidates.Reset();
+    TargetingSnapshot.LockedTargets.Reset();
+    TargetingSnapshot.NextLock = 0;
+
+    TArray<AActor*> VisibleActors;
+    TArray<AActor*> MeshActors = Player->GetActorsInConeFromCamera(Constants::c_MissileConeRadius, Constants::c_MissileConeTraceDistance, Constants::c_MissileConeAngle);
+    for (AActor* Actor : MeshActors)
+    {
+        if (!Actor)
+        {
+            continue;
+        }
+        if (Actor->Tags.Contains(FName("HomingTarget")) || Actor->GetClass()->ImplementsInterface(UTargetableInterface::StaticClass()))
+        {
+            if (Actor->WasRecentlyRendered(0.01f))
+            {
+                VisibleActors.Add(Actor);
+                TargetingSnapshot.Candidates.Add(Actor);
+            }
+        }
+    }
+
+    TArray<AActor*> TopTargets;
+    UClosestActorUtils::SelectTopScoringTargets(ViewLocation, ViewForward, Constants::c_MissileConeAngle, VisibleActors, Constants::c_MissileMaxLocks, TopTargets);
+    TargetingSnapshot.LockedTargets.Append(TopTargets);
+}
+
+/// <summary>AssignTarget points the missile at the target and records the pairing, so that the missile can be retargeted if the target is lost.</summary>
+/// <param>Takes the missile to guide and the actor it should home in on</param>
+/// <returns>return type is void</returns>
+void UMissileManagerSubsystem::AssignTarget(AMissileProjectile* Missile, AActor* Target)
+{
+    if (!Missile)
+    {
+        return;
+    }
+    ReleaseTarget(Missile);
+    Missile->SetHomingTarget(Target);
+    if (!Target)
+    {
+        return;
+    }
+
+    TArray<TWeakObjectPtr<AMissileProjectile>>& Chasers = MissilesByTarget.FindOrAdd(Target);
+    if (Chasers.IsEmpty())
+    {
+        // first missile on this target, so start listening for it leaving the world
+        Target->OnEndPlay.AddUniqueDynamic(this, &UMissileManagerSubsystem::HandleTargetEndPlay);
+    }
+    Chasers.Add(Missile);
+}
+
+void UMissileManagerSubsystem::ReleaseTarget(AMissileProjectile* Missile)
+{
+    AActor* Target = Missile ? Missile->GetHomingTarget() : nullptr;
+    if (!Target)
+    {
+        return;
+    }
+
+    if (TArray<TWeakObjectPtr<AMissileProjectile>>* Chasers = MissilesByTarget.Find(Target))
+    {
+        Chasers->RemoveSwap(Missile);
+        if (Chasers->IsEmpty())
+        {
+            MissilesByTarget.Remove(Target);
+            Target->OnEndPlay.RemoveDynamic(this, &UMissileManagerSubsystem::HandleTargetEndPlay);
+        }
+    }
+}
+
+/// <summary>NotifyTargetLost is called when a homing target is destroyed or loses the component that missiles home in on (e.g. the nuke destroying it).
+/// Every missile chasing it picks the next best target from the cached candidates without querying the scene. A missile with nothing left to chase is
+/// removed instead of flying blind until its lifetime runs out.</summary>
+/// <param>Takes the actor that is no longer a valid target</param>
+/// <returns>return type is void</returns>
+void UMissileManagerSubsystem::NotifyTargetLost(AActor* Target)
+{
+    TArray<TWeakObjectPtr<AMissileProjectile>> Chasers;
+    if (!MissilesByTarget.RemoveAndCopyValue(Target, Chasers))
+    {
+        return;
+    }
+    if (Target)
+    {
+        Target->OnEndPlay.RemoveDynamic(this, &UMissileManagerSubsystem::HandleTargetEndPlay);
+    }
+
+    for (const TWeakObjectPtr<AMissileProjectile>& Chaser : Chasers)
+    {
+        AMissileProjectile* Missile = Chaser.Get();
+        if (!Missile)
+        {
+            continue;
+        }
+        // the pairing has already been removed above, so clear it on the missile before handing out a new one
+        Missile->SetHomingTarget(nullptr);
+        if (AActor* NextTarget = FindNextTarget(Missile, Target))
+        {
+            AssignTarget(Missile, NextTarget);
+        }
+        else
+        {
+            Missile->Destroy();
+        }
+    }
+}
+
+void UMissileManagerSubsystem::HandleTargetEndPlay(AActor* Actor, EEndPlayReason::Type EndPlayReason)
+{
+    // only a target leaving a world that keeps running is worth chasing something else for. On a level transition, quit or the end of PIE
+    // the whole world is being torn down, missiles included.
+    if (EndPlayReason != EEndPlayReason::Destroyed && EndPlayReason != EEndPlayReason::RemovedFromWorld)
+    {
+        return;
+    }
+    NotifyTargetLost(Actor);
+}
+
+AActor* UMissileManagerSubsystem::FindNextTarget(AActor* Missile, AActor* LostTarget)
+{
+    // handed out in turn like at launch, so missiles orphaned together spread over the remaining locks instead of all taking the best one
+    if (AActor* Locked = TakeLockedTarget(LostTarget))
+    {
+        return Locked;
+    }
+
+    // every locked target is gone, fall back to whatever else was in sight
+    TArray<AActor*> Candidates;
+    Candidates.Reserve(TargetingSnapshot.Candidates.Num());
+    for (const TWeakObjectPtr<AActor>& Candidate : TargetingSnapshot.Candidates)
+    {
+        AActor* Actor = Candidate.Get();
+        if (IsValid(Actor) && Actor != LostTarget && Actor->GetRootComponent())
+        {
+            Candidates.Add(Actor);
+        }
+    }
+    return UClosestActorUtils::FindClosestRelevantActor(Missile->GetWorld(), Missile, Candidates, true);
+}
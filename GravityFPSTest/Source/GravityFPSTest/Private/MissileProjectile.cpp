@@ -12,9 +12,10 @@
 #include "ClosestActorUtils.h"
 #include "GravityFPSTest/GravityFPSTestCharacter.h"
 #include "MissileManager.h"
+#include "MissileGuidance.h"
 
 // Sets default values
-AMissileProjectile::AMissileProjectile() : LifeTime(10.0f)
+AMissileProjectile::AMissileProjectile() : LifeTime(10.0f), GuidanceIndex(INDEX_NONE), ManagerHandle(INDEX_NONE)
 {
     // Set this actor to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
     PrimaryActorTick.bCanEverTick = true;
@@ -38,8 +39,8 @@ AMissileProjectile::AMissileProjectile() : LifeTime(10.0f)
     ProjectileMovement->ProjectileGravityScale = 0.0f;
     ProjectileMovement->bRotationFollowsVelocity = false;
     ProjectileMovement->bShouldBounce = false;
-    ProjectileMovement->bIsHomingProjectile = true;
-    ProjectileMovement->HomingAccelerationMagnitude = 2000000.f;
+    // Homing is steered for all missiles at once by UMissileGuidanceSubsystem, the movement component only integrates the velocity it is given.
+    ProjectileMovement->bIsHomingProjectile = false;
 
     StaticMeshComponent->SetupAttachment(RootComponent);
     StaticMeshComponent->SetCollisionResponseToChannel(ECC_Visibility, ECR_Ignore);
@@ -102,44 +103,31 @@ void AMissileProjectile::BeginPlay()
 
     // this may need to be reworked for a networked game, unsure. But it works perfectly fine for a local one.
     AGravityFPSTestCharacter* Player = Cast<AGravityFPSTestCharacter>(UGameplayStatics::GetPlayerCharacter(this, 0));
-    TArray<AActor*> FoundActors;
-
-    UWorld* World = GetWorld();
-    TArray<AActor*> MeshActors;
-    MeshActors = Player->GetActorsInConeFromCamera(3600.0f, 15000000000, 45.0f);
-
-    for (AActor* Actor : MeshActors)
-    {
-        if (Actor->Tags.Contains(FName("HomingTarget")) || Actor->GetClass()->ImplementsInterface(UTargetableInterface::StaticClass()))
-        {
-            FoundActors.Add(Actor);
-        }
-    }
+    UMissileManagerSubsystem* Subsystem = GetGameInstance()->GetSubsystem<UMissileManagerSubsystem>();
 
-    TArray<AActor*> VisibleActors;
-    for (AActor* Actor : FoundActors)
+    // The subsystem shares one target acquisition between all missiles fired from (roughly) the same view, so a volley only queries the scene once.
+    AActor* Closest = Subsystem->AcquireTarget(Player, this);
+    if (Closest)
     {
-        if (Actor->WasRecentlyRendered(0.01f))
-        {
-            VisibleActors.Add(Actor);
-        }
+        Subsystem->AssignTarget(this, Closest);
     }
-
-    AActor* Closest = UClosestActorUtils::FindClosestRelevantActor(World, this, VisibleActors, true);
-    if (Closest)
+    Subsystem->RegisterMissile(this);
+    if (UMissileGuidanceSubsystem* Guidance = GetWorld()->GetSubsystem<UMissileGuidanceSubsystem>())
     {
-        ProjectileMovement->bIsHomingProjectile = true;
-        ProjectileMovement->HomingTargetComponent = Closest->GetRootComponent();
+        Guidance->RegisterMissile(this);
     }
-    UMissileManagerSubsystem* Subsystem = GetGameInstance()->GetSubsystem<UMissileManagerSubsystem>();
-    Subsystem->ActiveMissiles.Add(this);
 }
 
 void AMissileProjectile::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
     Super::EndPlay(EndPlayReason);
     UMissileManagerSubsystem* Subsystem = GetGameInstance()->GetSubsystem<UMissileManagerSubsystem>();
-    Subsystem->ActiveMissiles.Remove(this);
+    Subsystem->ReleaseTarget(this);
+    Subsystem->UnregisterMissile(this);
+    if (UMissileGuidanceSubsystem* Guidance = GetWorld()->GetSubsystem<UMissileGuidanceSubsystem>())
+    {
+        Guidance->UnregisterMissile(this);
+    }
 }
 // Called every frame
 void AMissileProjectile::Tick(float DeltaTime)
@@ -161,4 +149,18 @@ void AMissileProjectile::AddVelocity(FVector Velocity)
     {
         ProjectileMovement->Velocity += Velocity;
     }
+}
+
+/// <summary>Points the missile's homing at the given actor's root component. Should be called through UMissileManagerSubsystem::AssignTarget so that
+/// the missile is notified if the target is destroyed.</summary>
+/// <param name="Target">The actor to home in on, or nullptr to fly straight.</param>
+/// <returns>return type is void</returns>
+void AMissileProjectile::SetHomingTarget(AActor* Target)
+{
+    HomingTarget = Target;
+    if (ProjectileMovement)
+    {
+        // kept up to date for anything that inspects the movement component, the steering itself is done by UMissileGuidanceSubsystem.
+        ProjectileMovement->HomingTargetComponent = Target ? Target->GetRootComponent() : nullptr;
+    }
 }
\ No newline at end of file
@@ -0,0 +1,45 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "RadarBlipsWidget.h"
+#include "SRadarBlips.h"
+
+URadarBlipsWidget::URadarBlipsWidget(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer), BlipSize(8.0f, 8.0f), BlipColor(FLinearColor::Red)
+{
+    CountFont = FCoreStyle::GetDefaultFontStyle("Bold", 8);
+    SetVisibilityInternal(ESlateVisibility::HitTestInvisible);
+}
+
+void URadarBlipsWidget::SetBlips(TArrayView<const FVector2f> Positions, TArrayView<const int32> Counts)
+{
+    if (MyRadarBlips.IsValid())
+    {
+        MyRadarBlips->SetBlips(Positions, Counts);
+    }
+}
+
+void URadarBlipsWidget::SynchronizeProperties()
+{
+    Super::SynchronizeProperties();
+    if (MyRadarBlips.IsValid())
+    {
+        MyRadarBlips->SetBlipStyle(&BlipBrush, BlipSize, BlipColor);
+        MyRadarBlips->SetCountFont(CountFont);
+    }
+}
+
+void URadarBlipsWidget::ReleaseSlateResources(bool bReleaseChildren)
+{
+    Super::ReleaseSlateResources(bReleaseChildren);
+    MyRadarBlips.Reset();
+}
+
+TSharedRef<SWidget> URadarBlipsWidget::RebuildWidget()
+{
+    MyRadarBlips = SNew(SRadarBlips)
+        .BlipBrush(&BlipBrush)
+        .BlipSize(BlipSize)
+        .BlipColor(BlipColor)
+        .CountFont(CountFont);
+    return MyRadarBlips.ToSharedRef();
+}
@@ -0,0 +1,92 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "RadarDetection.h"
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+#include "Kismet/GameplayStatics.h"
+#include "UTargetableInterface.h"
+#include "GameplayPerfPanel.h"
+
+void FRadarDetection::Init(UObject* Owner)
+{
+    Delegate.BindWeakLambda(Owner, [this](const FTraceHandle& TraceHandle, FOverlapDatum& OverlapDatum)
+    {
+        OnOverlap(TraceHandle, OverlapDatum);
+    });
+}
+
+/// <summary>Update starts an asynchronous overlap around the player to find what should show up on the radar. The query runs alongside the rest
+/// of the frame on the physics threads and the results are picked up in OnOverlap, so the game thread never waits on it.</summary>
+/// <param>Takes the world to query, the pawn the radar is centred on, the radar's range and a name for the perf panel</param>
+/// <returns>return type is void</returns>
+void FRadarDetection::Update(UWorld* World, const APawn* Pawn, float Range, const TCHAR* QueryName)
+{
+    // the last query hasn't come back yet, no point stacking another one behind it
+    if (bPending || !World || !Pawn)
+    {
+        return;
+    }
+
+    FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(RadarDetection), false);
+    QueryParams.AddIgnoredActor(Pawn); // We ignore ourself so that we don't appear as a red dot on our own radar.
+
+    FGameplayPerfCounters::CountSceneQuery(QueryName);
+    World->AsyncOverlapByChannel(
+        Pawn->GetActorLocation(),
+        FQuat::Identity,
+        ECC_Visibility,       // Collision channel
+        FCollisionShape::MakeSphere(Range),
+        QueryParams,
+        FCollisionResponseParams::DefaultResponseParam,
+        &Delegate
+    );
+    QueryWorld = World;
+    bPending = true;
+}
+
+/// <summary>OnOverlap receives the result of the overlap started by Update. It filters the overlaps down to radar targets, samples each one's
+/// location and velocity into the back buffer and flips it to the front.</summary>
+/// <param>Takes the trace handle and the overlap results</param>
+/// <returns>return type is void</returns>
+void FRadarDetection::OnOverlap(const FTraceHandle& TraceHandle, FOverlapDatum& OverlapDatum)
+{
+    bPending = false;
+
+    // old actors should not persist
+    const int32 BackContactBuffer = 1 - FrontContactBuffer;
+    TArray<FRadarContact>& BackBuffer = ContactBuffers[BackContactBuffer];
+    BackBuffer.Reset();
+
+    for (const FOverlapResult& Overlap : OverlapDatum.OutOverlaps)
+    {
+        AActor* HitActor = Overlap.GetActor();
+        if (!HitActor || !IsRadarTarget(HitActor)) continue;
+
+        // an actor can overlap with more than one component
+        if (BackBuffer.ContainsByPredicate([HitActor](const FRadarContact& Contact) { return Contact.Actor == HitActor; }))
+        {
+            continue;
+        }
+        FRadarContact& Contact = BackBuffer.AddDefaulted_GetRef();
+        Contact.Actor = HitActor;
+        Contact.Location = HitActor->GetActorLocation();
+        Contact.Velocity = HitActor->GetVelocity();
+    }
+#if 0
+    if (APawn* DebugPawn = UGameplayStatics::GetPlayerPawn(QueryWorld.Get(), 0)) // Activate for debugging Radar offset.
+    {
+        BackBuffer.Add({ DebugPawn, DebugPawn->GetActorLocation(), FVector::ZeroVector });
+    }
+#endif
+
+    FGameplayPerfCounters::SetRadarContacts(BackBuffer.Num());
+    const UWorld* World = QueryWorld.Get();
+    ContactSampleTimes[BackContactBuffer] = World ? World->GetTimeSeconds() : 0.0f;
+    FrontContactBuffer = BackContactBuffer;
+}
+
+bool FRadarDetection::IsRadarTarget(const AActor* Actor)
+{
+    return Actor->Tags.Contains(FName("HomingTarget")) || Actor->GetClass()->ImplementsInterface(UTargetableInterface::StaticClass());
+}
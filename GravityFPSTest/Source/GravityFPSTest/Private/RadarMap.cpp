@@ -3,11 +3,19 @@
 
 #include "RadarMap.h"
 #include "Kismet/GameplayStatics.h"
-#include "BlipUserWidget.h"
+#include "RadarBlipsWidget.h"
+#include "RadarProjection.h"
+#include "Blueprint/WidgetTree.h"
 #include "Components/CanvasPanelSlot.h"
 #include "Constants.h"
 #include "GravityFPSTest/GravityFPSTestCharacter.h"
 
+URadarMap::URadarMap(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
+{
+    // the blips are repainted on every display update, so an invalidation panel would be invalidated every time and cache nothing
+    bCacheWithInvalidationPanel = false;
+}
+
 void URadarMap::NativeConstruct()
 {
     Super::NativeConstruct();
@@ -15,59 +23,66 @@ void URadarMap::NativeConstruct()
     bInitialized = false;
     bMustUpdateRadarSize = true;
 
-    // call EventUpdateDetection every one fourth of a second
-    GetWorld()->GetTimerManager().SetTimer(OneSecondTimerHandle, this, &URadarMap::EventUpdateDetection, 0.2f, true);
-    GetWorld()->GetTimerManager().SetTimer(NativeTickHandle, this, &URadarMap::FakeNativeTick, 0.1f, true);
+    if (!RadarBlips && WidgetTree)
+    {
+        RadarBlips = WidgetTree->ConstructWidget<URadarBlipsWidget>(URadarBlipsWidget::StaticClass(), TEXT("RadarBlips"));
+        if (UCanvasPanelSlot* CanvasSlot = CP_Blips->AddChildToCanvas(RadarBlips))
+        {
+            // stretch over the whole canvas so blip positions are in the same space as before
+            CanvasSlot->SetAnchors(FAnchors(0.0f, 0.0f, 1.0f, 1.0f));
+            CanvasSlot->SetOffsets(FMargin(0.0f));
+        }
+    }
+
+    Detection.Init(this);
+
+    RestartUpdateTimers();
+    RegisterHUDTimer(OneSecondTimerHandle);
+    RegisterHUDTimer(NativeTickHandle);
 }
 
 void URadarMap::NativeTick(const FGeometry& MyGeometry, float InDeltaTime)
 {
-    
+    Super::NativeTick(MyGeometry, InDeltaTime);
+
+    // no display timer in this case, blips are updated every frame
+    if (DisplayInterval <= 0.0f && !IsHUDSuspended())
+    {
+        FakeNativeTick();
+    }
 }
 
-void URadarMap::EventUpdateDetection()
+void URadarMap::SetUpdateRates(float NewDetectionInterval, float NewDisplayInterval)
 {
-    TArray<FHitResult> HitResults;
-    AController* pController = UGameplayStatics::GetPlayerController(GetWorld(), 0);
-    APawn* Pawn = pController->GetPawn();
-    FVector Start = Pawn->GetActorLocation();
-    FVector End = Start + FVector(0.0f, 0.0f, DetectionRange);
-    float Radius = DetectionRange; // Sphere radius
-
-    FCollisionQueryParams QueryParams;
-    QueryParams.AddIgnoredActor(Pawn); // We ignore ourself so that we don't appear as a red dot on our own radar.
-
-    bool bHit = GetWorld()->SweepMultiByChannel(
-        HitResults,
-        Start,
-        End,
-        FQuat::Identity,
-        ECC_Visibility,       // Collision channel
-     // FCollisionShape::MakeCapsule(Radius, 18000),
-        FCollisionShape::MakeSphere(Radius),
-        QueryParams
-    );
-
-    // old actors should not persist
-    EnemyActors.Empty();
-
-    if (bHit)
+    DetectionInterval = NewDetectionInterval;
+    DisplayInterval = NewDisplayInterval;
+    RestartUpdateTimers();
+}
+
+/// <summary>RestartUpdateTimers (re)starts the detection and display timers from DetectionInterval and DisplayInterval.</summary>
+/// <returns>return type is void</returns>
+void URadarMap::RestartUpdateTimers()
+{
+    FTimerManager& TimerManager = GetWorld()->GetTimerManager();
+    TimerManager.SetTimer(OneSecondTimerHandle, this, &URadarMap::EventUpdateDetection, FMath::Max(DetectionInterval, 0.01f), true);
+    if (DisplayInterval > 0.0f)
     {
-        for (const FHitResult& Hit : HitResults)
-        {
-            AActor* HitActor = Hit.GetActor();
-            if (!HitActor) continue;
-
-            if (HitActor->Tags.Contains(FName("HomingTarget")) || HitActor->GetClass()->ImplementsInterface(UTargetableInterface::StaticClass()))
-            {
-                EnemyActors.AddUnique(HitActor);
-        //        GEngine->AddOnScreenDebugMessage(-1, 5.0f, FColor::Green, FString::Printf(TEXT("Blocked by: %s"), *Hit.GetActor()->GetName()));
-            }
-#if 0
-            EnemyActors.AddUnique(Pawn); // Activate for debugging Radar offset.
-#endif
-        }
+        TimerManager.SetTimer(NativeTickHandle, this, &URadarMap::FakeNativeTick, DisplayInterval, true);
+    }
+    else
+    {
+        TimerManager.ClearTimer(NativeTickHandle);
     }
+    // restarted timers start running, even if the radar is hidden
+    ApplyHUDTimerState();
+}
+
+/// <summary>EventUpdateDetection starts the next radar detection around the player. The results come back asynchronously, see FRadarDetection.</summary>
+/// <returns>return type is void</returns>
+void URadarMap::EventUpdateDetection()
+{
+    AController* pController = UGameplayStatics::GetPlayerController(GetWorld(), 0);
+    Detection.Update(GetWorld(), pController ? pController->GetPawn() : nullptr, DetectionRange, TEXT("RadarDetection"));
 }
 
 void URadarMap::FakeNativeTick()
@@ -84,68 +99,100 @@ void URadarMap::FakeNativeTick()
 
             bInitialized = true;
         }
+        else
+        {
+            return;
+        }
     }
 
-    CP_Blips->ClearChildren();
+    // blips are no longer widgets, only positions handed to RadarBlips which paints them all at once
+    BlipPositions.Reset();
     AController* pController = UGameplayStatics::GetPlayerController(GetWorld(), 0);
-    APawn* Pawn = pController->GetPawn();
+    APawn* Pawn = pController ? pController->GetPawn() : nullptr;
+    if (!Pawn)
+    {
+        return;
+    }
     FVector PlayerLocation = Pawn->GetActorLocation();
     FRotator PlayerRotation = Pawn->GetActorRotation();
     PlayerRotation.Pitch = 0;
     PlayerRotation.Roll = 0;
     PlayerRotation.Yaw += 90.0f; // add rotation offset here
 
-    FRotator RadarRotation = FRotator(0.0f, -PlayerRotation.Yaw, 0.0f);
+    // contacts are moved along their sampled velocity for however long it has been since they were detected, but never for longer than
+    // a couple of detections so a contact that stopped being detected doesn't drift off
+    const float ExtrapolationTime = FMath::Clamp(GetWorld()->GetTimeSeconds() - Detection.GetSampleTime(), 0.0f, 2.0f * DetectionInterval);
 
-    for (AActor* Actor : EnemyActors)
+    // offsets from the player are taken in double precision here, everything after that is float and done four contacts at a time
+    const TArray<FRadarContact>& Contacts = Detection.GetContacts();
+    ProjectionBatch.Reset(Contacts.Num());
+    for (const FRadarContact& Contact : Contacts)
     {
-        FVector EnemyLocation = Actor->GetActorLocation();
-        FVector DisplacementFromPlayer = EnemyLocation - PlayerLocation;
+        // contacts can be a detection behind, anything destroyed since is simply skipped
+        if (!Contact.Actor.IsValid()) continue;
 
-        FRotator InverseRotation = FRotator(0.0f, -PlayerRotation.Yaw, 0.0f);
-        FVector Displacement2 = InverseRotation.RotateVector(DisplacementFromPlayer);
-        DisplacementFromPlayer = Displacement2;
+        ProjectionBatch.Add(Contact.Location + Contact.Velocity * ExtrapolationTime - PlayerLocation);
+    }
+    ProjectionBatch.Pad();
 
-        // we do not care about our z value here.
-        DisplacementFromPlayer.Z = 0.0f;
+    // we do not care about our z value here, and anything outside of the radar's range doesn't get a blip
+    FRadarProjection(-PlayerRotation.Yaw, DetectionRange, WidgetRadiusInPixels.X).ProjectBatch(ProjectionBatch, BlipPositions);
 
-        //   GEngine->AddOnScreenDebugMessage(-1, 5.0f, FColor::Green, FString::Printf(TEXT("Displacement = %f, %f"), DisplacementFromPlayer.X, DisplacementFromPlayer.Y));
-           // we divide by detection range here so that the object will appear within our radar scope.
-        float Distance = DisplacementFromPlayer.Length();
+    ClusterBlips();
 
-        //   GEngine->AddOnScreenDebugMessage(-1, 5.0f, FColor::Green, FString::Printf(TEXT("Distance = %f"), Distance));
+    if (RadarBlips)
+    {
+        RadarBlips->SetBlips(BlipPositions, BlipCounts);
+    }
+}
 
-        Distance /= WidgetScaleFactor;
-        DisplacementFromPlayer.Normalize();
-        DisplacementFromPlayer *= Distance;
+/// <summary>ClusterBlips bins this update's blip positions into a grid and replaces them with one blip per occupied cell, placed at the average
+/// of the contacts in it. Nothing happens while the radar is sparse enough to draw every contact.</summary>
+/// <returns>return type is void</returns>
+void URadarMap::ClusterBlips()
+{
+    BlipCounts.Reset();
+    if (!bInitialized || BlipPositions.Num() <= ClusterMinContacts)
+    {
+        return;
+    }
+
+    const float CellSize = GetClusterCellSize();
+    const int32 GridSize = FMath::Max(1, FMath::CeilToInt32(RadarSize.X / CellSize));
+    ClusterCells.Init(INDEX_NONE, GridSize * GridSize);
+    ClusteredPositions.Reset();
 
-        if (BlipWidgetClass)
+    for (const FVector2f& Position : BlipPositions)
+    {
+        const int32 CellX = FMath::Clamp(FMath::FloorToInt32(Position.X / CellSize), 0, GridSize - 1);
+        const int32 CellY = FMath::Clamp(FMath::FloorToInt32(Position.Y / CellSize), 0, GridSize - 1);
+        int32& Cluster = ClusterCells[CellY * GridSize + CellX];
+        if (Cluster == INDEX_NONE)
+        {
+            Cluster = ClusteredPositions.Add(Position);
+            BlipCounts.Add(1);
+        }
+        else
         {
-            if (UBlipUserWidget* BlipWidget = CreateWidget<UBlipUserWidget>(GetWorld(), BlipWidgetClass))
-            {
-                if (Distance < WidgetRadiusInPixels.X)
-                {
-                    CP_Blips->AddChild(BlipWidget);
-                    UCanvasPanelSlot* CanvasSlot = Cast<UCanvasPanelSlot>(BlipWidget->Slot);
-
-                    if (CanvasSlot)
-                    {
-                        FVector2D FinalPosition = FVector2D(DisplacementFromPlayer.X, DisplacementFromPlayer.Y) + WidgetRadiusInPixels;
-
-                        //               if (Actor->Tags.Contains(FName("ObjectOfInterest")))
-                        {
-#if 0
-                            UE_LOG(LogTemp, Warning, TEXT("RadarSize = %9.5f, %9.5f / Player Pos = %6.2f, %6.2f / Enemy %-20s Pos = %6.2f, %6.2f / Disp = %6.2f, %6.2f / on Radar = %6.2f, %6.2f"),
-                                RadarSize.X, RadarSize.Y, PlayerLocation.X, PlayerLocation.Y, *Actor->GetName(), EnemyLocation.X, EnemyLocation.Y,
-                                DisplacementFromPlayer.X, DisplacementFromPlayer.Y,
-                                FinalPosition.X, FinalPosition.Y);
-#endif
-                        }
-                        CanvasSlot->SetAlignment(FVector2D(0.5f, 0.5f)); // Ensure pivot is centered
-                        CanvasSlot->SetPosition(FinalPosition);
-                    }
-                }
-            }
+            ClusteredPositions[Cluster] += Position;
+            ++BlipCounts[Cluster];
         }
     }
+
+    for (int32 i = 0; i < ClusteredPositions.Num(); ++i)
+    {
+        ClusteredPositions[i] /= static_cast<float>(BlipCounts[i]);
+    }
+    Swap(BlipPositions, ClusteredPositions);
 }
+
+/// <summary>GetClusterCellSize works out how big a clustering cell should be for the current zoom and number of contacts.</summary>
+/// <returns>return type is float, the cell size in pixels</returns>
+float URadarMap::GetClusterCellSize() const
+{
+    // zoomed out, the same pixel covers more of the world, so contacts bunch up faster
+    const float ZoomScale = DetectionRange / FMath::Max(ClusterReferenceRange, 1.0f);
+    // and the more crowded the radar is, the coarser the grid can get before it stops being readable
+    const float DensityScale = FMath::Clamp(FMath::Sqrt(static_cast<float>(BlipPositions.Num()) / FMath::Max(ClusterMinContacts, 1)), 1.0f, FMath::Max(ClusterMaxDensityScale, 1.0f));
+    return FMath::Max(ClusterCellSize * ZoomScale * DensityScale, 1.0f);
+}
\ No newline at end of file
@@ -0,0 +1,169 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "RadarProjection.h"
+#include "HAL/IConsoleManager.h"
+
+void FRadarProjectionBatch::Reset(int32 Capacity)
+{
+    Num = 0;
+    const int32 Padded = Align(Capacity, 4);
+    OffsetX.Reset(Padded);
+    OffsetY.Reset(Padded);
+}
+
+void FRadarProjectionBatch::Add(const FVector& Offset)
+{
+    OffsetX.Add(Offset.X);
+    OffsetY.Add(Offset.Y);
+    ++Num;
+}
+
+void FRadarProjectionBatch::Pad()
+{
+    // padded lanes are skipped when the results are written out
+    const int32 Padded = Align(Num, 4);
+    OffsetX.SetNumZeroed(Padded);
+    OffsetY.SetNumZeroed(Padded);
+}
+
+FRadarProjection::FRadarProjection(float RadarYaw, float Range, float RadiusInPixels)
+{
+    float Sin, Cos;
+    FMath::SinCos(&Sin, &Cos, FMath::DegreesToRadians(RadarYaw));
+    const float WorldToPixels = RadiusInPixels / FMath::Max(Range, UE_KINDA_SMALL_NUMBER);
+    ScaledCos = Cos * WorldToPixels;
+    ScaledSin = Sin * WorldToPixels;
+    RangeSquared = Range * Range;
+    Center = RadiusInPixels;
+}
+
+/// <summary>ProjectBatch rotates, scales and range culls four contacts at a time. The culling is done on squared distance in world units, so no
+/// square root or normalize is needed, and only lanes that are in range are written out.</summary>
+/// <param>Takes the padded batch of offsets and the array to append radar positions to</param>
+/// <returns>return type is int32, the number of positions appended</returns>
+int32 FRadarProjection::ProjectBatch(const FRadarProjectionBatch& Batch, TArray<FVector2f>& OutPositions) const
+{
+    const VectorRegister4Float Cos = VectorSetFloat1(ScaledCos);
+    const VectorRegister4Float Sin = VectorSetFloat1(ScaledSin);
+    const VectorRegister4Float RangeSq = VectorSetFloat1(RangeSquared);
+    const VectorRegister4Float Centre = VectorSetFloat1(Center);
+
+    const int32 StartNum = OutPositions.Num();
+    const int32 Padded = Batch.OffsetX.Num();
+    for (int32 i = 0; i < Padded; i += 4)
+    {
+        const VectorRegister4Float X = VectorLoad(&Batch.OffsetX[i]);
+        const VectorRegister4Float Y = VectorLoad(&Batch.OffsetY[i]);
+
+        const int32 InRange = VectorMaskBits(VectorCompareLT(VectorMultiplyAdd(X, X, VectorMultiply(Y, Y)), RangeSq));
+        if (InRange == 0)
+        {
+            continue;
+        }
+
+        // x' = x cos - y sin, y' = x sin + y cos, then moved to the middle of the radar
+        const VectorRegister4Float Px = VectorAdd(VectorSubtract(VectorMultiply(X, Cos), VectorMultiply(Y, Sin)), Centre);
+        const VectorRegister4Float Py = VectorMultiplyAdd(X, Sin, VectorMultiplyAdd(Y, Cos, Centre));
+
+        alignas(16) float OutX[4];
+        alignas(16) float OutY[4];
+        VectorStoreAligned(Px, OutX);
+        VectorStoreAligned(Py, OutY);
+        const int32 Lanes = FMath::Min(4, Batch.Num - i);
+        for (int32 Lane = 0; Lane < Lanes; ++Lane)
+        {
+            if (InRange & (1 << Lane))
+            {
+                OutPositions.Emplace(OutX[Lane], OutY[Lane]);
+            }
+        }
+    }
+    return OutPositions.Num() - StartNum;
+}
+
+int32 FRadarProjection::ProjectReference(float RadarYaw, float Range, float RadiusInPixels, const TArray<FVector>& Offsets, TArray<FVector2f>& OutPositions)
+{
+    const int32 StartNum = OutPositions.Num();
+    const float WidgetScaleFactor = Range / RadiusInPixels;
+    for (const FVector& Offset : Offsets)
+    {
+        FRotator InverseRotation = FRotator(0.0f, RadarYaw, 0.0f);
+        FVector DisplacementFromPlayer = InverseRotation.RotateVector(Offset);
+        DisplacementFromPlayer.Z = 0.0f;
+
+        float Distance = DisplacementFromPlayer.Length();
+        Distance /= WidgetScaleFactor;
+        DisplacementFromPlayer.Normalize();
+        DisplacementFromPlayer *= Distance;
+
+        if (Distance >= RadiusInPixels)
+        {
+            continue;
+        }
+        OutPositions.Add(FVector2f(FVector2D(DisplacementFromPlayer.X, DisplacementFromPlayer.Y) + FVector2D(RadiusInPixels, RadiusInPixels)));
+    }
+    return OutPositions.Num() - StartNum;
+}
+
+/// <summary>Console command timing the projection kernel against the old per contact path on random contacts around the player.
+/// Usage: Radar.BenchmarkProjection [Contacts] [Iterations]</summary>
+static FAutoConsoleCommand RadarBenchmarkProjectionCommand(
+    TEXT("Radar.BenchmarkProjection"),
+    TEXT("Times the radar projection kernel against the per contact path. Usage: Radar.BenchmarkProjection [Contacts] [Iterations]"),
+    FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+    {
+        const int32 NumContacts = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 1000;
+        const int32 Iterations = Args.Num() > 1 ? FMath::Max(1, FCString::Atoi(*Args[1])) : 1000;
+        const float Range = 1000.0f;
+        const float RadiusInPixels = 128.0f;
+        const float RadarYaw = 37.0f;
+
+        // contacts spread over twice the range, so about three quarters of them get culled
+        FRandomStream Random(1234);
+        TArray<FVector> Offsets;
+        FRadarProjectionBatch Batch;
+        Batch.Reset(NumContacts);
+        for (int32 i = 0; i < NumContacts; ++i)
+        {
+            const FVector Offset(Random.FRandRange(-2.0f * Range, 2.0f * Range), Random.FRandRange(-2.0f * Range, 2.0f * Range), Random.FRandRange(-100.0f, 100.0f));
+            Offsets.Add(Offset);
+            Batch.Add(Offset);
+        }
+        Batch.Pad();
+
+        TArray<FVector2f> ReferencePositions;
+        TArray<FVector2f> KernelPositions;
+        ReferencePositions.Reserve(NumContacts);
+        KernelPositions.Reserve(NumContacts);
+
+        double StartTime = FPlatformTime::Seconds();
+        for (int32 i = 0; i < Iterations; ++i)
+        {
+            ReferencePositions.Reset();
+            FRadarProjection::ProjectReference(RadarYaw, Range, RadiusInPixels, Offsets, ReferencePositions);
+        }
+        const double ReferenceTime = FPlatformTime::Seconds() - StartTime;
+
+        StartTime = FPlatformTime::Seconds();
+        for (int32 i = 0; i < Iterations; ++i)
+        {
+            KernelPositions.Reset();
+            FRadarProjection(RadarYaw, Range, RadiusInPixels).ProjectBatch(Batch, KernelPositions);
+        }
+        const double KernelTime = FPlatformTime::Seconds() - StartTime;
+
+        // both paths should agree, give or take float precision and contacts right on the edge of the range
+        float MaxError = 0.0f;
+        if (ReferencePositions.Num() == KernelPositions.Num())
+        {
+            for (int32 i = 0; i < KernelPositions.Num(); ++i)
+            {
+                MaxError = FMath::Max(MaxError, FVector2f::Distance(ReferencePositions[i], KernelPositions[i]));
+            }
+        }
+
+        UE_LOG(LogTemp, Log, TEXT("Radar projection, %d contacts x %d iterations: per contact %.3f ms, kernel %.3f ms (%.1fx). Blips %d / %d, max error %.4f px"),
+            NumContacts, Iterations, ReferenceTime * 1000.0, KernelTime * 1000.0, ReferenceTime / FMath::Max(KernelTime, 1e-9),
+            ReferencePositions.Num(), KernelPositions.Num(), MaxError);
+    }));
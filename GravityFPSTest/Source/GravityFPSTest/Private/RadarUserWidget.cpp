@@ -3,6 +3,12 @@
 
 #include "RadarUserWidget.h"
 
+URadarUserWidget::URadarUserWidget(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
+{
+    // holds the radar map, which repaints on every display update, so caching here would be thrown away just as often
+    bCacheWithInvalidationPanel = false;
+}
+
 bool URadarUserWidget::Initialize()
 {
     bool bResult = Super::Initialize();
@@ -0,0 +1,112 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "SRadarBlips.h"
+
+void SRadarBlips::Construct(const FArguments& InArgs)
+{
+    SetBlipStyle(InArgs._BlipBrush, InArgs._BlipSize, InArgs._BlipColor);
+    SetCountFont(InArgs._CountFont);
+    // the radar is never interactive
+    SetVisibility(EVisibility::HitTestInvisible);
+}
+
+void SRadarBlips::SetBlips(TArrayView<const FVector2f> InPositions, TArrayView<const int32> InCounts)
+{
+    check(InCounts.Num() == 0 || InCounts.Num() == InPositions.Num());
+    Positions = InPositions;
+    Counts = InCounts;
+    CountLabels.SetNum(Counts.Num());
+    for (int32 i = 0; i < Counts.Num(); ++i)
+    {
+        if (Counts[i] > 1)
+        {
+            CountLabels[i] = FString::FromInt(Counts[i]);
+        }
+        else
+        {
+            CountLabels[i].Reset();
+        }
+    }
+    Invalidate(EInvalidateWidgetReason::Paint);
+}
+
+void SRadarBlips::SetBlipStyle(const FSlateBrush* InBrush, const FVector2D& InSize, const FLinearColor& InColor)
+{
+    BlipBrush = InBrush ? InBrush : FCoreStyle::Get().GetBrush("WhiteBrush");
+    BlipSize = FVector2f(InSize);
+    BlipColor = InColor;
+    Invalidate(EInvalidateWidgetReason::Paint);
+}
+
+void SRadarBlips::SetCountFont(const FSlateFontInfo& InFont)
+{
+    CountFont = InFont;
+    Invalidate(EInvalidateWidgetReason::Paint);
+}
+
+int32 SRadarBlips::OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements,
+    int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const
+{
+    const FLinearColor Tint = InWidgetStyle.GetColorAndOpacityTint() * BlipColor;
+    const FVector2f HalfSize = BlipSize * 0.5f;
+    bool bHasLabels = false;
+    for (int32 i = 0; i < Positions.Num(); ++i)
+    {
+        const FVector2f& Position = Positions[i];
+        if (Counts.IsValidIndex(i) && Counts[i] > 1)
+        {
+            // clusters grow slowly with the number of contacts so a big cluster doesn't cover the radar
+            const FVector2f ClusterSize = BlipSize * FMath::Min(1.0f + 0.5f * FMath::Log2(static_cast<float>(Counts[i])), 3.0f);
+            FSlateDrawElement::MakeBox(
+                OutDrawElements,
+                LayerId,
+                AllottedGeometry.ToPaintGeometry(ClusterSize, FSlateLayoutTransform(Position - ClusterSize * 0.5f)),
+                BlipBrush,
+                ESlateDrawEffect::None,
+                Tint);
+            bHasLabels = true;
+            continue;
+        }
+
+        // blips are centred on their position
+        FSlateDrawElement::MakeBox(
+            OutDrawElements,
+            LayerId,
+            AllottedGeometry.ToPaintGeometry(BlipSize, FSlateLayoutTransform(Position - HalfSize)),
+            BlipBrush,
+            ESlateDrawEffect::None,
+            Tint);
+    }
+
+    if (!bHasLabels)
+    {
+        return LayerId;
+    }
+
+    // counts go on a layer above all the boxes so the boxes still batch together
+    const int32 TextLayer = LayerId + 1;
+    const FLinearColor TextTint = InWidgetStyle.GetColorAndOpacityTint();
+    for (int32 i = 0; i < CountLabels.Num(); ++i)
+    {
+        if (CountLabels[i].IsEmpty())
+        {
+            continue;
+        }
+        FSlateDrawElement::MakeText(
+            OutDrawElements,
+            TextLayer,
+            AllottedGeometry.ToPaintGeometry(BlipSize, FSlateLayoutTransform(Positions[i] + FVector2f(BlipSize.X, -BlipSize.Y))),
+            CountLabels[i],
+            CountFont,
+            ESlateDrawEffect::None,
+            TextTint);
+    }
+    return TextLayer;
+}
+
+FVector2D SRadarBlips::ComputeDesiredSize(float LayoutScaleMultiplier) const
+{
+    // fills whatever space the parent gives it
+    return FVector2D::ZeroVector;
+}
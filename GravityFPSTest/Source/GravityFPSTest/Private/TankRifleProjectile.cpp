@@ -13,6 +13,7 @@
 #include "ClosestActorUtils.h"
 #include "PhysicsEngine/RadialForceComponent.h"
 #include "GravityFPSTest/GravityFPSTestCharacter.h"
+#include "MissileManager.h"
 
 // Sets default values
 ATankRifleProjectile::ATankRifleProjectile() : LifeTime(10.0f)
@@ -78,6 +79,11 @@ void ATankRifleProjectile::OnHit(UPrimitiveComponent* HitComp, AActor* OtherActo
             // destroy the actor only if it does not have the Indestructible tag.
             if (!OtherActor->Tags.Contains(FName("Indestructible")))
             {
+                // missiles home in on the root component, so let any that are chasing this actor find something else.
+                if (OtherComp == OtherActor->GetRootComponent())
+                {
+                    GetGameInstance()->GetSubsystem<UMissileManagerSubsystem>()->NotifyTargetLost(OtherActor);
+                }
                 OtherComp->DestroyComponent();
             }
             playSound = false;
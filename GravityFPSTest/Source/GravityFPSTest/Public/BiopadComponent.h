@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
+#include "UObject/SoftObjectPtr.h"
 #include "BiopadComponent.generated.h"
 
 
@@ -19,6 +20,35 @@ struct FActorInfoDisplay
 	FVector Distance;
 };
 
+/// <summary>
+/// Stable handle to a tracked actor. The index is reused once an actor stops being tracked, so the serial tells a stale handle apart from
+/// the actor that took its slot.
+/// </summary>
+struct FBiopadHandle
+{
+	int32 Index = INDEX_NONE;
+	uint32 Serial = 0;
+};
+
+/// <summary>
+/// A tracked actor. Nothing here keeps the actor loaded: while its cell is streamed out the entry keeps showing the actor where it was last
+/// seen, and the soft pointer finds it again once the cell is back.
+/// </summary>
+struct FBiopadEntry
+{
+	TWeakObjectPtr<AActor> Actor;
+	// The persistent record of which actor this is. An actor's soft object path is the same in editor and cooked builds and across streaming,
+	// so it is both the lookup key and what the actor is re-resolved from (the actor GUID only exists in editor builds).
+	TSoftObjectPtr<AActor> SoftActor;
+	uint32 Serial = 0;
+	// Taken once when the actor is selected, GetName allocates a new string every call.
+	FString DisplayName;
+	FTransform LastTransform = FTransform::Identity;
+	bool bStreamedOut = false;
+	FVector Offset = FVector::ZeroVector;
+	double DistanceSquared = 0.0;
+};
+
 UCLASS( ClassGroup=(Custom), meta=(BlueprintSpawnableComponent) )
 class GRAVITYFPSTEST_API UBiopadComponent : public UActorComponent
 {
@@ -34,22 +64,49 @@ public:
 	UFUNCTION(BlueprintCallable)
 	void RemoveLastSelected();
 
+	// Rows for every tracked actor, nearest first. Only rebuilt when asked for, and only if something moved or the selection changed.
 	UFUNCTION(BlueprintCallable)
-	const TArray<FActorInfoDisplay>& GetActorDisplayData() { return DisplayData; };
+	const TArray<FActorInfoDisplay>& GetActorDisplayData() { RefreshDisplayData(); return DisplayData; };
+
+	// Goes up every time the display data is rebuilt, so callers can tell whether it changed since they last looked.
+	uint32 GetDisplayDataVersion() const { return DisplayDataVersion; };
+
+	bool IsTracked(const AActor* Actor) const { return HandlesByPath.Contains(FSoftObjectPath(Actor)); };
+	int32 GetNumTracked() const { return Entries.Num(); };
 
 protected:
 	// Called when the game starts
 	virtual void BeginPlay() override;
 
-	UPROPERTY(BlueprintReadOnly)
-	TArray<AActor*> SelectedActors;
+	FBiopadHandle AddEntry(AActor* Actor);
+	void RemoveEntry(const FBiopadHandle& Handle);
+	bool IsValidHandle(const FBiopadHandle& Handle) const { return Entries.IsValidIndex(Handle.Index) && Entries[Handle.Index].Serial == Handle.Serial; };
+	void UpdateSortedOrder();
+	void RefreshDisplayData();
+	void WatchActor(AActor* Actor);
+	void UnwatchActor(AActor* Actor);
+
+	UFUNCTION()
+	void HandleTrackedActorEndPlay(AActor* Actor, EEndPlayReason::Type EndPlayReason);
+
+	// Tracked actors. Lookups by actor go through HandlesByPath, so selecting and removing are both O(1). The path stays the same when an
+	// actor is streamed out and back in, unlike the object itself.
+	TSparseArray<FBiopadEntry> Entries;
+	TMap<FSoftObjectPath, FBiopadHandle> HandlesByPath;
+	uint32 NextSerial = 1;
+
+	// Handles in the order they were selected, oldest from SelectionHead on. Removing the oldest just moves the head along.
+	TArray<FBiopadHandle> SelectionOrder;
+	int32 SelectionHead = 0;
+
+	// Handles nearest first. Kept from one update to the next, so resorting is cheap when little moved.
+	TArray<FBiopadHandle> SortedHandles;
 
 	UPROPERTY(BlueprintReadOnly)
 	TArray<FActorInfoDisplay> DisplayData;
+	uint32 DisplayDataVersion = 0;
 
-public:	
-	// Called every frame
-	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
-
-		
+	// Set when actors are selected or removed. Movement is picked up by comparing against the last locations.
+	bool bSelectionChanged = false;
+	FVector LastPlayerLocation = FVector::ZeroVector;
 };
@@ -0,0 +1,51 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/Widget.h"
+#include "Widgets/Views/SListView.h"
+#include "BiopadListWidget.generated.h"
+
+/// <summary>
+/// One line of biopad text and the rounded values it was built from, so the line is only rebuilt when what it shows changes.
+/// </summary>
+struct FBiopadRowText
+{
+	FString Name;
+	FIntVector Coordinates = FIntVector::ZeroValue;
+	int32 Distance = 0;
+	bool bDistanceMode = false;
+	bool bBuilt = false;
+	FText Text;
+};
+
+/**
+ * Scrolling list of biopad rows. Backed by a Slate list view, so only the rows that fit on screen have widgets, however many actors are tracked.
+ */
+UCLASS()
+class GRAVITYFPSTEST_API UBiopadListWidget : public UWidget
+{
+	GENERATED_BODY()
+
+public:
+	UBiopadListWidget(const FObjectInitializer& ObjectInitializer);
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Appearance")
+	FSlateFontInfo Font;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Appearance")
+	FSlateColor ColorAndOpacity;
+
+	// Sets the rows to list. Rows whose text changes later update on their own, this only needs calling when rows are added or removed.
+	void SetRows(const TArray<TSharedPtr<FBiopadRowText>>& Rows);
+
+	virtual void ReleaseSlateResources(bool bReleaseChildren) override;
+
+protected:
+	virtual TSharedRef<SWidget> RebuildWidget() override;
+	TSharedRef<ITableRow> GenerateRow(TSharedPtr<FBiopadRowText> Row, const TSharedRef<STableViewBase>& OwnerTable);
+
+	TArray<TSharedPtr<FBiopadRowText>> Items;
+	TSharedPtr<SListView<TSharedPtr<FBiopadRowText>>> MyListView;
+};
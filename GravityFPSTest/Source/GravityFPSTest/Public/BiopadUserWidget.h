@@ -3,33 +3,49 @@
 #pragma once
 
 #include "CoreMinimal.h"
-#include "Blueprint/UserWidget.h"
+#include "HUDUserWidget.h"
+#include "BiopadListWidget.h"
 #include "BiopadUserWidget.generated.h"
 
-class AGravityFPSTestCharacter;
+struct FActorInfoDisplay;
+
 /**
  * This class is responsible for displaying text on the screen that shows the whereabouts of the player's
  * position in reference to logged objects. The logging logic happens in the BiopadComponent class.
  */
 UCLASS()
-class GRAVITYFPSTEST_API UBiopadUserWidget : public UUserWidget
+class GRAVITYFPSTEST_API UBiopadUserWidget : public UHUDUserWidget
 {
 	GENERATED_BODY()
 	virtual bool Initialize() override;
 
-	virtual void NativeTick(const FGeometry& MyGeometry, float InDeltaTime) override;
+	virtual void NativeConstruct() override;
+	virtual void NativeDestruct() override;
 
 public:
-	void ToggleDistance() { DistanceInsteadOfCoordinates = !DistanceInsteadOfCoordinates; };
+	void ToggleDistance();
 
 protected:
-	FString FormatSignedInt(int32 Value);
-
-	AGravityFPSTestCharacter* PlayerCharacter;
+	static void AppendSignedInt(FStringBuilderBase& Builder, int32 Value);
+	void DisplayRows(const TArray<FActorInfoDisplay>& ActorsToDisplay);
+	void RefreshRows();
+	bool UpdateRowText(FBiopadRowText& Row, const FActorInfoDisplay& Actor) const;
 
 	bool DistanceInsteadOfCoordinates;
 
-	/** Reference to the Text Block in the UI */
-	UPROPERTY(meta = (BindWidget))
+	// Asks for new rows while the biopad is on screen, paused while it is hidden.
+	FTimerHandle RefreshRowsHandle;
+
+	// Cached text for each row, nearest actor first.
+	TArray<TSharedPtr<FBiopadRowText>> RowTexts;
+	// All rows joined together, only used when there is no list to show them in.
+	FString ScreenText;
+
+	/** Reference to the Text Block in the UI. Replaced by BiopadList at runtime if the blueprint doesn't have one. */
+	UPROPERTY(meta = (BindWidgetOptional))
 	class UTextBlock* BiopadScreenText;
+
+	/** Virtualized list of rows. */
+	UPROPERTY(meta = (BindWidgetOptional))
+	UBiopadListWidget* BiopadList;
 };
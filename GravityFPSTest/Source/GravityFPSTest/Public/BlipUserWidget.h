@@ -1,21 +0,0 @@
-// Fill out your copyright notice in the Description page of Project Settings.
-
-#pragma once
-
-#include "CoreMinimal.h"
-#include "Blueprint/UserWidget.h"
-#include "BlipUserWidget.generated.h"
-
-/**
- * 
- */
-UCLASS()
-class GRAVITYFPSTEST_API UBlipUserWidget : public UUserWidget
-{
-	GENERATED_BODY()
-
-	virtual void NativeConstruct() override;
-
-	virtual void NativeTick(const FGeometry& MyGeometry, float InDeltaTime) override;
-	
-};
@@ -0,0 +1,85 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/HUD.h"
+#include "RadarDetection.h"
+#include "RadarProjection.h"
+#include "CanvasHUD.generated.h"
+
+class UTexture2D;
+class UFont;
+class UHUDModelSubsystem;
+
+/// <summary>
+/// A native HUD that draws the fuel bar, invisibility countdown, equipment icon, helmet overlay and radar in a single Canvas pass, from the
+/// same HUD model and radar detection the UMG widgets use. None of the UMG HUD widgets are created while it is in use. It is meant for
+/// low end and benchmark builds, and for measuring what UMG costs us, and is picked with -CanvasHUD on the command line or ?CanvasHUD in
+/// the map URL.
+/// </summary>
+UCLASS()
+class GRAVITYFPSTEST_API ACanvasHUD : public AHUD
+{
+	GENERATED_BODY()
+
+public:
+	ACanvasHUD();
+
+	virtual void DrawHUD() override;
+
+	// Whether the canvas HUD was asked for, either on the command line or in the game options.
+	static bool IsRequested(const FString& Options);
+
+	// The HUD is spawned from this native class, not a blueprint, so the constructor points these at the same font, helmet overlay and icons
+	// the UMG widgets use. They are soft references loaded in BeginPlay, so sessions using the UMG HUD never load them.
+	UPROPERTY(EditAnywhere, Category = "HUD")
+	TSoftObjectPtr<UFont> Font;
+
+	UPROPERTY(EditAnywhere, Category = "HUD")
+	TSoftObjectPtr<UTexture2D> HelmetOverlay;
+
+	UPROPERTY(EditAnywhere, Category = "HUD")
+	TMap<FName, TSoftObjectPtr<UTexture2D>> EquipmentIcons;
+
+	// Size of the radar on screen, in pixels from its centre to its edge.
+	UPROPERTY(EditAnywhere, Category = "HUD|Radar")
+	float RadarRadius = 128.0f;
+
+	UPROPERTY(EditAnywhere, Category = "HUD|Radar")
+	float RadarRange = 1000.0f;
+
+	// Seconds between scene queries for radar contacts, blips are extrapolated in between.
+	UPROPERTY(EditAnywhere, Category = "HUD|Radar")
+	float DetectionInterval = 0.2f;
+
+protected:
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	void DrawHelmet(float Opacity);
+	void DrawFuel(float Percent);
+	void DrawInvisibility(int32 SecondsRemaining);
+	void DrawEquipmentIcon();
+	void DrawRadar(const APawn* Pawn);
+
+	void HandleEquipmentChanged(FName Equipment);
+	void UpdateDetection();
+
+	UHUDModelSubsystem* GetHUDModel() const;
+
+	// Fades are driven by RenderDelta, so nothing here ticks.
+	float HelmetOpacity = 0.0f;
+	float IconOpacity = 0.0f;
+	UTexture2D* IconToDisplay = nullptr;
+
+	// The same detection the radar widget runs.
+	FRadarDetection Detection;
+	FTimerHandle DetectionTimerHandle;
+
+	// Keeps the font, helmet and icons loaded while the HUD is in play.
+	TSharedPtr<struct FStreamableHandle> AssetsHandle;
+
+	FRadarProjectionBatch ProjectionBatch;
+	TArray<FVector2f> BlipPositions;
+};
@@ -21,5 +21,9 @@ public:
 
 	// Unreal gets real fussy if you try to initialize a TArray inside a function declaration, so the overloaded function calls the one above but passes in a blank TArray
 	static AActor* FindClosestRelevantActor(UWorld* World, AActor* ReferenceActor, const TArray<AActor*>& ActorList, bool IncludeStaticMesh = false);
+
+	// Rates every candidate on distance, angle off the view direction and apparent size, and returns the best MaxTargets of them, best first.
+	static void SelectTopScoringTargets(const FVector& ViewLocation, const FVector& ViewForward, float ConeAngle, const TArray<AActor*>& Candidates,
+		int32 MaxTargets, TArray<AActor*>& OutTargets);
 	
 };
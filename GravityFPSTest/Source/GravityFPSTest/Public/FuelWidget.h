@@ -3,7 +3,7 @@
 #pragma once
 
 #include "CoreMinimal.h"
-#include "Blueprint/UserWidget.h"
+#include "HUDUserWidget.h"
 #include "Components/ProgressBar.h"
 #include "FuelWidget.generated.h"
 
@@ -11,13 +11,14 @@
  * 
  */
 UCLASS()
-class GRAVITYFPSTEST_API UFuelWidget : public UUserWidget
+class GRAVITYFPSTEST_API UFuelWidget : public UHUDUserWidget
 {
 	GENERATED_BODY()
 
 	virtual bool Initialize() override;
 
-	virtual void NativeTick(const FGeometry& MyGeometry, float InDeltaTime) override;
+	virtual void NativeConstruct() override;
+	virtual void NativeDestruct() override;
 
 public:
 	/** Sets the bar fill percentage (0.0 to 1.0) */
@@ -0,0 +1,71 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Widgets/SCompoundWidget.h"
+
+/// <summary>
+/// Counters gameplay code reports into for the performance panel. Nothing is recorded unless the panel is open, so while it is closed
+/// each report is a single branch.
+/// </summary>
+struct GRAVITYFPSTEST_API FGameplayPerfCounters
+{
+	static bool IsEnabled() { return bEnabled; };
+
+	// Call next to every scene query, with a short name for whoever is running it.
+	static void CountSceneQuery(const TCHAR* Caller)
+	{
+		if (bEnabled)
+		{
+			++SceneQueries.FindOrAdd(Caller);
+		}
+	};
+
+	static void SetRadarContacts(int32 Num)
+	{
+		if (bEnabled)
+		{
+			RadarContacts = Num;
+		}
+	};
+
+private:
+	friend class SGameplayPerfPanel;
+
+	static bool bEnabled;
+	// Scene queries by caller since the panel last sampled them.
+	static TMap<FName, int32> SceneQueries;
+	static int32 RadarContacts;
+};
+
+/// <summary>
+/// A small native overlay with live gameplay counters: projectiles by class, missiles in flight, radar contacts, biopad rows, scene queries
+/// per frame by caller, live widgets and game thread time. It samples them a few times a second while it is open and does nothing at all
+/// while it is closed. Toggled with the Perf.GameplayPanel console command.
+/// </summary>
+class GRAVITYFPSTEST_API SGameplayPerfPanel : public SCompoundWidget
+{
+public:
+	SLATE_BEGIN_ARGS(SGameplayPerfPanel)
+		: _SampleInterval(0.25f)
+		{}
+		SLATE_ARGUMENT(TWeakObjectPtr<UWorld>, World)
+		SLATE_ARGUMENT(float, SampleInterval)
+	SLATE_END_ARGS()
+
+	void Construct(const FArguments& InArgs);
+	virtual ~SGameplayPerfPanel();
+
+	// Opens the panel over the given world's viewport, or closes it if it is already open.
+	static void Toggle(UWorld* World);
+
+private:
+	EActiveTimerReturnType Sample(double InCurrentTime, float InDeltaTime);
+
+	TWeakObjectPtr<UWorld> World;
+	FText Text;
+	uint64 LastSampleFrame = 0;
+
+	static TWeakPtr<SGameplayPerfPanel> OpenPanel;
+};
@@ -0,0 +1,74 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "GravityCharacterMovementComponent.generated.h"
+
+/// <summary>
+/// The custom movement modes the player can be in, stored in CustomMovementMode while MovementMode is MOVE_Custom.
+/// </summary>
+UENUM(BlueprintType)
+enum class EGravityMovementMode : uint8
+{
+	None      UMETA(Hidden),
+	Thrusting UMETA(DisplayName = "Thrusting"),
+	WallRun   UMETA(DisplayName = "Wall Run"),
+};
+
+/// <summary>
+/// Character movement with the armour's thrust flight and the human's wall running as movement modes of their own. Both are integrated in
+/// PhysCustom, so they are sub-stepped, swept and resolved against collision like every other mode instead of having their velocity and
+/// gravity overwritten by the character every frame.
+/// </summary>
+UCLASS()
+class GRAVITYFPSTEST_API UGravityCharacterMovementComponent : public UCharacterMovementComponent
+{
+	GENERATED_BODY()
+
+public:
+	// Thrust flight. The flying velocity is kept between flights, StartThrusting turns it by how far the player has turned since the last one.
+	void StartThrusting(float YawSinceLastFlight);
+	void StopThrusting();
+	void SetThrustInput(const FVector& Input) { ThrustInput = Input; };
+	void ResetFlyingVelocity() { FlyingVelocity = FVector::ZeroVector; };
+	bool IsThrusting() const { return IsCustomMode(EGravityMovementMode::Thrusting); };
+
+	// Wall running. Calling StartWallRun again while already on a wall only updates the wall normal.
+	void StartWallRun(const FVector& InWallNormal);
+	void StopWallRun();
+	bool IsWallRunning() const { return IsCustomMode(EGravityMovementMode::WallRun); };
+	const FVector& GetWallNormal() const { return WallNormal; };
+
+	// Both custom modes used to be MOVE_Falling, and the first person animation blueprint (and the engine's jump and landing logic) still ask
+	// IsFalling to tell whether the player is off the ground, so it stays true while thrusting or wall running.
+	virtual bool IsFalling() const override { return Super::IsFalling() || IsThrusting() || IsWallRunning(); };
+
+	// Falling, thrusting or running along a wall, either way the player is off the ground.
+	UFUNCTION(BlueprintPure, Category = "Character Movement")
+	bool IsAirborne() const { return IsFalling(); };
+
+	// Whether the player was touching anything in the last movement update, either standing on a walkable floor or running into something.
+	// It comes from the floor and impacts movement already works out for itself, so asking costs no scene query.
+	bool IsTouchingSurface() const { return bTouchingSurface; };
+
+	virtual float GetMaxSpeed() const override;
+	virtual void TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+	virtual void HandleImpact(const FHitResult& Hit, float TimeSlice = 0.0f, const FVector& MoveDelta = FVector::ZeroVector) override;
+
+protected:
+	virtual void PhysCustom(float deltaTime, int32 Iterations) override;
+
+	void PhysThrusting(float deltaTime, int32 Iterations);
+	void PhysWallRun(float deltaTime, int32 Iterations);
+
+	bool IsCustomMode(EGravityMovementMode Mode) const { return MovementMode == MOVE_Custom && CustomMovementMode == static_cast<uint8>(Mode); };
+
+	FVector ThrustInput = FVector::ZeroVector;
+	FVector FlyingVelocity = FVector::ZeroVector;
+	FVector WallNormal = FVector::ZeroVector;
+
+	bool bTouchingSurface = false;
+	bool bImpactThisUpdate = false;
+};
@@ -0,0 +1,55 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/LocalPlayerSubsystem.h"
+#include "BiopadComponent.h"
+#include "HUDModelSubsystem.generated.h"
+
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnHUDFuelChanged, float /*Percent*/);
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnHUDInvisibilityChanged, int32 /*SecondsRemaining*/);
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnHUDEquipmentChanged, FName /*Equipment*/);
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnHUDBiopadRowsChanged, const TArray<FActorInfoDisplay>& /*Rows*/);
+
+class AController;
+
+/**
+ * Holds the values the HUD displays for one local player. Gameplay code pushes values in and HUD widgets subscribe to the delegates, which only
+ * broadcast when a value changes by enough to show up on screen. Widgets no longer have to poll the player every frame.
+ */
+UCLASS()
+class GRAVITYFPSTEST_API UHUDModelSubsystem : public ULocalPlayerSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// Finds the model for the local player behind the given controller, nullptr for AI or remote controllers.
+	static UHUDModelSubsystem* Get(const AController* Controller);
+
+	void SetFuelPercent(float Percent);
+	float GetFuelPercent() const { return FuelPercent; };
+	FOnHUDFuelChanged OnFuelChanged;
+
+	void SetInvisibilityTimeRemaining(float Seconds);
+	int32 GetInvisibilitySecondsRemaining() const { return InvisibilitySecondsRemaining; };
+	FOnHUDInvisibilityChanged OnInvisibilityChanged;
+
+	void SetEquipment(FName Equipment);
+	FName GetEquipment() const { return Equipment; };
+	FOnHUDEquipmentChanged OnEquipmentChanged;
+
+	void SetBiopadRows(const TArray<FActorInfoDisplay>& Rows);
+	// Asks the player's biopad for its rows and publishes them if they changed. Called by whoever displays them, as often as they need.
+	void RefreshBiopadRows();
+	const TArray<FActorInfoDisplay>& GetBiopadRows() const { return BiopadRows; };
+	FOnHUDBiopadRowsChanged OnBiopadRowsChanged;
+
+protected:
+	float FuelPercent = 1.0f;
+	int32 InvisibilitySecondsRemaining = 0;
+	FName Equipment;
+	TArray<FActorInfoDisplay> BiopadRows;
+	TWeakObjectPtr<UBiopadComponent> BiopadSource;
+	uint32 BiopadRowsVersion = 0;
+};
@@ -0,0 +1,60 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Blueprint/UserWidget.h"
+#include "HUDUserWidget.generated.h"
+
+class UHUDModelSubsystem;
+
+/**
+ * Base class for HUD widgets that only need to do work while they can be seen. When the widget is hidden or collapsed, or sits inside a HUD
+ * widget that is, its registered timers are paused and it stops ticking. Both resume when it is shown again.
+ */
+UCLASS()
+class GRAVITYFPSTEST_API UHUDUserWidget : public UUserWidget
+{
+	GENERATED_BODY()
+
+public:
+	virtual void SetVisibility(ESlateVisibility InVisibility) override;
+
+	bool IsHUDSuspended() const { return bHUDSuspended; };
+
+protected:
+	virtual void NativeConstruct() override;
+	virtual void NativeDestruct() override;
+	virtual TSharedRef<SWidget> RebuildWidget() override;
+
+	// Puts the widget behind an invalidation panel so Slate caches its layout and paint, and only redoes the parts that change. Widgets that
+	// repaint on every update (the radar) turn it off, since they would pay for the panel without ever hitting its cache.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Performance")
+	bool bCacheWithInvalidationPanel = true;
+
+	// The HUD model of the player that owns this widget, where values to display are published.
+	UHUDModelSubsystem* GetHUDModel() const;
+
+	// Timers registered here are paused while the widget is suspended and cleared when it is destroyed. The handle must outlive the widget's
+	// construction, so it should be a member.
+	void RegisterHUDTimer(FTimerHandle& Handle);
+	// Brings registered timers in line with the suspended state, e.g. after one of them was restarted.
+	void ApplyHUDTimerState();
+
+	// Widgets that only need to tick some of the time (e.g. while a fade plays) say so here. The widget ticks while it wants to and is not suspended.
+	void SetHUDTickWanted(bool bWanted);
+
+	// Called when the widget stops or starts being visible, after timers and ticking have been updated.
+	virtual void OnHUDSuspended() {};
+	virtual void OnHUDResumed() {};
+
+private:
+	void SetParentSuspended(bool bSuspended);
+	void RefreshHUDSuspension();
+	void ApplyHUDTickState();
+
+	TArray<FTimerHandle*> HUDTimers;
+	bool bHUDSuspended = false;
+	bool bParentSuspended = false;
+	bool bHUDTickWanted = true;
+};
@@ -3,14 +3,15 @@
 #pragma once
 
 #include "CoreMinimal.h"
-#include "Blueprint/UserWidget.h"
+#include "HUDUserWidget.h"
 #include "HelmetUserWidget.generated.h"
 
 /**
- *
+ * The helmet overlay. It is cached behind the HUD widget's invalidation panel, so it is only laid out and painted again when a fade changes its
+ * opacity, and it only ticks while a fade is playing.
  */
 UCLASS()
-class GRAVITYFPSTEST_API UHelmetUserWidget : public UUserWidget
+class GRAVITYFPSTEST_API UHelmetUserWidget : public UHUDUserWidget
 {
 	GENERATED_BODY()
 
@@ -38,4 +39,10 @@ protected:
 
 	EHelmetState helmetState;
 
+	UPROPERTY(meta = (BindWidgetOptional))
+	UWidget* HelmetImage;
+
+	UPROPERTY(meta = (BindWidgetOptional))
+	UWidget* HelmetImageOpacity;
+
 };
\ No newline at end of file
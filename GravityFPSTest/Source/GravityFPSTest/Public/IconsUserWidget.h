@@ -3,7 +3,7 @@
 #pragma once
 
 #include "CoreMinimal.h"
-#include "Blueprint/UserWidget.h"
+#include "HUDUserWidget.h"
 #include "IconsUserWidget.generated.h"
 
 /**
@@ -12,25 +12,40 @@
  */
 class UImage;
 UCLASS()
-class GRAVITYFPSTEST_API UIconsUserWidget : public UUserWidget
+class GRAVITYFPSTEST_API UIconsUserWidget : public UHUDUserWidget
 {
 	GENERATED_BODY()
 
 	virtual bool Initialize() override;
 	virtual void NativeTick(const FGeometry& MyGeometry, float InDeltaTime) override;
+	virtual void NativeConstruct() override;
+	virtual void NativeDestruct() override;
 
 public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Icons")
 	TMap<FName, UTexture2D*> EquipmentIcons;
 
+	// Every equipment icon packed into one texture, so whatever is equipped is drawn from the same resource. When this is set, each icon is
+	// the UV rectangle (0 to 1) given for it in EquipmentIconRegions and EquipmentIcons is ignored.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Icons")
+	UTexture2D* EquipmentIconAtlas;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Icons")
+	TMap<FName, FBox2D> EquipmentIconRegions;
+
 	UPROPERTY(meta = (BindWidget))
 	UImage* EquipmentImage;
 
 	void SetDisplayLabel(FName name);
 
 protected:
+	void BuildIconBrushes();
+
 	float pct;
-	UTexture2D* IconToDisplay;
+
+	// One brush per equipment, built once when the widget is constructed. Changing equipment only swaps which one the image shows.
+	TMap<FName, FSlateBrush> IconBrushes;
+	const FSlateBrush* BrushToDisplay;
 
 //	DO NOT IGNORE ME. // will force the program to crash. Comment this out to run it. This is here so that you read the TODO line at the top and don't forget about it.
 };
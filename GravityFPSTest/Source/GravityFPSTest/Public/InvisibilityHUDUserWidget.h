@@ -3,23 +3,24 @@
 #pragma once
 
 #include "CoreMinimal.h"
-#include "Blueprint/UserWidget.h"
+#include "HUDUserWidget.h"
 #include "InvisibilityHUDUserWidget.generated.h"
 
 /**
  * 
  */
 UCLASS()
-class GRAVITYFPSTEST_API UInvisibilityHUDUserWidget : public UUserWidget
+class GRAVITYFPSTEST_API UInvisibilityHUDUserWidget : public UHUDUserWidget
 {
 	GENERATED_BODY()
 	
 	virtual bool Initialize() override;
 
-	virtual void NativeTick(const FGeometry& MyGeometry, float InDeltaTime) override;
+	virtual void NativeConstruct() override;
+	virtual void NativeDestruct() override;
 
 public:
-	void DisplayCountDown();
+	void DisplayCountDown(int32 SecondsRemaining);
 
 protected:
 	/** Reference to the Text Block in the UI */
@@ -0,0 +1,54 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "MissileGuidance.generated.h"
+
+class AMissileProjectile;
+
+/// <summary>
+/// Structure of arrays holding everything the guidance pass needs for every missile that has a target. Arrays are padded to a multiple of four so
+/// the steering kernel can always work on four missiles at a time. Positions are stored as the target's offset from the missile, taken in double
+/// precision before being narrowed, so guidance stays accurate far from the world origin.
+/// </summary>
+struct FMissileGuidanceBatch
+{
+	int32 Num = 0;
+	TArray<float> VelX, VelY, VelZ;
+	TArray<float> OffsetX, OffsetY, OffsetZ;
+	TArray<float> TargetVelX, TargetVelY, TargetVelZ;
+	TArray<AMissileProjectile*> Missiles;
+
+	void Reset(int32 Capacity);
+	void Add(AMissileProjectile* Missile, const FVector& Position, const FVector& Velocity, const FVector& TargetPosition, const FVector& TargetVelocity);
+	void Pad();
+};
+
+/**
+ * Steers every live missile in one pass per frame instead of each UProjectileMovementComponent running its own homing.
+ * Uses proportional navigation on the line of sight to a lead point predicted from the target's velocity.
+ */
+UCLASS()
+class GRAVITYFPSTEST_API UMissileGuidanceSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	void RegisterMissile(AMissileProjectile* Missile);
+	void UnregisterMissile(AMissileProjectile* Missile);
+
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override { RETURN_QUICK_DECLARE_CYCLE_STAT(UMissileGuidanceSubsystem, STATGROUP_Tickables); };
+
+protected:
+	void GatherBatch();
+	void ComputeSteering(float DeltaTime);
+	void WriteBackVelocities();
+
+	// missiles being guided, each missile stores its own index so removal is a swap with the last element.
+	TArray<AMissileProjectile*> GuidedMissiles;
+
+	FMissileGuidanceBatch Batch;
+};
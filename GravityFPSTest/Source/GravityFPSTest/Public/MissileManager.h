@@ -8,6 +8,27 @@
 #include "MissileManager.generated.h"
 
 class AMissileProjectile;
+class AGravityFPSTestCharacter;
+
+/// <summary>
+/// The result of one target acquisition (cone sweep, occlusion traces and render filter) along with the view it was taken from.
+/// Missiles fired while the view is still within tolerance of this snapshot reuse the candidates instead of querying the scene again.
+/// </summary>
+struct FMissileTargetingSnapshot
+{
+	FVector ViewLocation = FVector::ZeroVector;
+	FVector ViewForward = FVector::ForwardVector;
+	float TimeStamp = 0.0f;
+	// The subsystem outlives the world, and world time restarts on a map change, so the snapshot is only usable in the world it was taken in.
+	TWeakObjectPtr<const UWorld> World;
+	bool bValid = false;
+	TArray<TWeakObjectPtr<AActor>> Candidates;
+
+	// The best scoring candidates, best first. Missiles in a salvo are handed these in turn.
+	TArray<TWeakObjectPtr<AActor>> LockedTargets;
+	int32 NextLock = 0;
+};
+
 UCLASS()
 class GRAVITYFPSTEST_API UMissileManagerSubsystem : public UGameInstanceSubsystem
 {
@@ -16,11 +37,42 @@ class GRAVITYFPSTEST_API UMissileManagerSubsystem : public UGameInstanceSubsyste
 public:	
 	// Sets default values for this actor's properties
 	
-	UPROPERTY()
-	TArray<TWeakObjectPtr<class AMissileProjectile>> ActiveMissiles;
+	// Missiles in flight. Each missile keeps its index as a handle, indices stay stable and freed slots are reused, so registering and
+	// unregistering are both O(1).
+	TSparseArray<TWeakObjectPtr<class AMissileProjectile>> ActiveMissiles;
+
+	void RegisterMissile(AMissileProjectile* Missile);
+
+	void UnregisterMissile(AMissileProjectile* Missile);
+
+	// Query params that ignore the given player and every missile in flight. Missiles are added as they register and left in place when they are
+	// removed, the list is only rebuilt when the player changes or dead entries outnumber live ones.
+	const FCollisionQueryParams& GetMissileQueryParams(const AActor* Player);
+
+	AActor* AcquireTarget(AGravityFPSTestCharacter* Player, AActor* Missile);
+	void InvalidateTargetingSnapshot() { TargetingSnapshot.bValid = false; };
+
+	// Homing target bookkeeping, so missiles can be told when the thing they are chasing disappears.
+	void AssignTarget(AMissileProjectile* Missile, AActor* Target);
+	void ReleaseTarget(AMissileProjectile* Missile);
+	void NotifyTargetLost(AActor* Target);
+
+protected:
+	UFUNCTION()
+	void HandleTargetEndPlay(AActor* Actor, EEndPlayReason::Type EndPlayReason);
+
+	// Hands out the next live locked target in turn, other than Skip, or nullptr if every one of them is gone.
+	AActor* TakeLockedTarget(const AActor* Skip = nullptr);
+	AActor* FindNextTarget(AActor* Missile, AActor* LostTarget);
+	bool IsSnapshotUsable(const UWorld* World, const FVector& ViewLocation, const FVector& ViewForward, float Now) const;
+	void RefreshTargetingSnapshot(AGravityFPSTestCharacter* Player, const FVector& ViewLocation, const FVector& ViewForward, float Now);
 
-	void RegisterMissile(AMissileProjectile* Missile) { ActiveMissiles.Add(Missile); };
+	FMissileTargetingSnapshot TargetingSnapshot;
 
-	void UnregisterMissile(AMissileProjectile* Missile) { ActiveMissiles.Remove(Missile); };
+	FCollisionQueryParams MissileQueryParams;
+	TWeakObjectPtr<const AActor> QueryParamsPlayer;
+	bool bMissileQueryParamsDirty = true;
 
+	// Every target that currently has at least one missile homing in on it, and the missiles chasing it.
+	TMap<TWeakObjectPtr<AActor>, TArray<TWeakObjectPtr<AMissileProjectile>>> MissilesByTarget;
 };
@@ -59,7 +59,18 @@ public:
 	virtual void Tick(float DeltaTime) override;
 
 	void AddVelocity(FVector Velocity);
+
+	void SetHomingTarget(AActor* Target);
+	AActor* GetHomingTarget() const { return HomingTarget.Get(); };
+
 private:
+	friend class UMissileGuidanceSubsystem;
+	friend class UMissileManagerSubsystem;
+
+	TWeakObjectPtr<AActor> HomingTarget;
+	int32 GuidanceIndex;
+	int32 ManagerHandle;
+
 	UFUNCTION()
 	void OnHit(UPrimitiveComponent* HitComp, AActor* OtherActor, UPrimitiveComponent* OtherComp, FVector NormalImpulse, const FHitResult& Hit);
 
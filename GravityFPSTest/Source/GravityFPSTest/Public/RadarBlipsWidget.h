@@ -0,0 +1,44 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/Widget.h"
+#include "RadarBlipsWidget.generated.h"
+
+class SRadarBlips;
+
+/**
+ * UMG wrapper around SRadarBlips so the radar can be placed in a widget blueprint. All blips are drawn by the one widget instead of one child per blip.
+ */
+UCLASS()
+class GRAVITYFPSTEST_API URadarBlipsWidget : public UWidget
+{
+	GENERATED_BODY()
+
+public:
+	URadarBlipsWidget(const FObjectInitializer& ObjectInitializer);
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Appearance")
+	FSlateBrush BlipBrush;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Appearance")
+	FVector2D BlipSize;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Appearance")
+	FLinearColor BlipColor;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Appearance")
+	FSlateFontInfo CountFont;
+
+	/** Replaces the blips being drawn. Positions are in the widget's local space, in pixels. Counts, if given, holds how many contacts each blip stands for. */
+	void SetBlips(TArrayView<const FVector2f> Positions, TArrayView<const int32> Counts = TArrayView<const int32>());
+
+	virtual void SynchronizeProperties() override;
+	virtual void ReleaseSlateResources(bool bReleaseChildren) override;
+
+protected:
+	virtual TSharedRef<SWidget> RebuildWidget() override;
+
+	TSharedPtr<SRadarBlips> MyRadarBlips;
+};
@@ -0,0 +1,49 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "WorldCollision.h"
+
+/// <summary>
+/// A contact as it was when the radar last detected it. Blips are drawn from these samples, extrapolated along the sampled velocity,
+/// so the display can update more often than detection runs.
+/// </summary>
+struct FRadarContact
+{
+	TWeakObjectPtr<AActor> Actor;
+	FVector Location = FVector::ZeroVector;
+	FVector Velocity = FVector::ZeroVector;
+};
+
+/// <summary>
+/// Radar contact detection shared by the radar widget and the canvas HUD. Each update starts an asynchronous overlap around the player, the
+/// results are filtered down to radar targets and written into a back buffer that is then flipped to the front, so whoever draws the blips
+/// only ever reads a complete list and never waits on the query.
+/// </summary>
+struct GRAVITYFPSTEST_API FRadarDetection
+{
+	// Binds the query results to the object that owns this detection, they are dropped if it is gone by the time they arrive.
+	void Init(UObject* Owner);
+
+	// Starts an overlap of the given range around the pawn, unless the last one hasn't come back yet. The name is what the perf panel counts it as.
+	void Update(UWorld* World, const APawn* Pawn, float Range, const TCHAR* QueryName);
+
+	const TArray<FRadarContact>& GetContacts() const { return ContactBuffers[FrontContactBuffer]; };
+	// World time the current contacts were sampled at.
+	float GetSampleTime() const { return ContactSampleTimes[FrontContactBuffer]; };
+
+	// Whether an actor found by the detection overlap should show up on the radar.
+	static bool IsRadarTarget(const AActor* Actor);
+
+protected:
+	void OnOverlap(const FTraceHandle& TraceHandle, FOverlapDatum& OverlapDatum);
+
+	TArray<FRadarContact> ContactBuffers[2];
+	float ContactSampleTimes[2] = { 0.0f, 0.0f };
+	int32 FrontContactBuffer = 0;
+
+	FOverlapDelegate Delegate;
+	TWeakObjectPtr<UWorld> QueryWorld;
+	bool bPending = false;
+};
@@ -3,16 +3,18 @@
 #pragma once
 
 #include "CoreMinimal.h"
-#include "Blueprint/UserWidget.h"
+#include "HUDUserWidget.h"
 #include "Components/CanvasPanel.h"
+#include "RadarDetection.h"
+#include "RadarProjection.h"
 #include "RadarMap.generated.h"
 
 /**
  * 
  */
-class UBlipUserWidget;
+class URadarBlipsWidget;
 UCLASS()
-class GRAVITYFPSTEST_API URadarMap : public UUserWidget
+class GRAVITYFPSTEST_API URadarMap : public UHUDUserWidget
 {
 	GENERATED_BODY()
 	
@@ -20,14 +22,33 @@ class GRAVITYFPSTEST_API URadarMap : public UUserWidget
 
 	virtual void NativeTick(const FGeometry& MyGeometry, float InDeltaTime) override;
 public:
+	URadarMap(const FObjectInitializer& ObjectInitializer);
+
 	UPROPERTY(meta = (BindWidget))
 	UCanvasPanel* CP_Blips;
 
+	// Seconds between scene queries for contacts. Can be raised on low end machines without making blips jumpy, since they are extrapolated in between.
+	// Read only at runtime, change it with SetUpdateRates so the timers pick it up.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Radar|Update Rates")
+	float DetectionInterval = 0.2f;
+
+	// Seconds between blip updates. Zero or less updates every frame. Read only at runtime, like DetectionInterval.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Radar|Update Rates")
+	float DisplayInterval = 0.1f;
+
+	// Changes both update rates and restarts the radar timers with them.
+	UFUNCTION(BlueprintCallable, Category = "Radar")
+	void SetUpdateRates(float NewDetectionInterval, float NewDisplayInterval);
+
 protected:
 	void EventUpdateDetection();
 	void FakeNativeTick();
+	void RestartUpdateTimers();
+	void ClusterBlips();
+	float GetClusterCellSize() const;
 	
-	TArray<AActor*> EnemyActors;
+	// Contacts are double buffered by the detection, the display update only ever reads a complete list.
+	FRadarDetection Detection;
 	float DetectionRange;
 	FVector2D WidgetRadiusInPixels;
 	float WidgetScaleFactor;
@@ -38,7 +59,34 @@ protected:
 	bool bInitialized;
 	bool bMustUpdateRadarSize;
 
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = UI)
-	TSubclassOf<UBlipUserWidget> BlipWidgetClass;
-//	UBlipUserWidget* BlipWidget;
+	// Draws every blip in one paint pass. Can be placed in the blueprint to style it, otherwise one is created inside CP_Blips.
+	UPROPERTY(meta = (BindWidgetOptional))
+	URadarBlipsWidget* RadarBlips;
+
+	// Offsets of this update's contacts from the player, fed to the projection kernel.
+	FRadarProjectionBatch ProjectionBatch;
+
+	// Radar space positions of this update's blips, kept around so the allocation is reused.
+	TArray<FVector2f> BlipPositions;
+	// How many contacts each blip stands for. Empty unless the contacts were clustered.
+	TArray<int32> BlipCounts;
+	// Scratch space for clustering: the cluster each grid cell maps to, and the clustered positions.
+	TArray<int32> ClusterCells;
+	TArray<FVector2f> ClusteredPositions;
+
+	// Once there are more contacts than this on the radar they are binned into a grid and drawn as one blip per cell, with a count.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Radar|Clustering")
+	int32 ClusterMinContacts = 32;
+
+	// Size of a grid cell in pixels at the reference range.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Radar|Clustering")
+	float ClusterCellSize = 16.0f;
+
+	// Radar range the cell size is tuned for. Zooming out past it makes the cells bigger, zooming in makes them smaller.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Radar|Clustering")
+	float ClusterReferenceRange = 1000.0f;
+
+	// How much the cells are allowed to grow as the radar gets more crowded, as a multiple of the cell size.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Radar|Clustering")
+	float ClusterMaxDensityScale = 2.0f;
 };
@@ -0,0 +1,41 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/// <summary>
+/// Structure of arrays holding the offset from the player of every radar contact, in world units. Arrays are padded to a multiple of four so the
+/// projection kernel can always work on four contacts at a time.
+/// </summary>
+struct FRadarProjectionBatch
+{
+	int32 Num = 0;
+	TArray<float> OffsetX, OffsetY;
+
+	void Reset(int32 Capacity);
+	void Add(const FVector& Offset);
+	void Pad();
+};
+
+/// <summary>
+/// Turns offsets from the player into pixel positions on the radar: rotated so the player faces up, scaled from world units to pixels and
+/// centred on the radar. Anything outside the radar's range is dropped in the same pass.
+/// </summary>
+struct GRAVITYFPSTEST_API FRadarProjection
+{
+	FRadarProjection(float RadarYaw, float Range, float RadiusInPixels);
+
+	// Projects a whole batch four contacts at a time, appending the ones in range to OutPositions. Returns how many were appended.
+	int32 ProjectBatch(const FRadarProjectionBatch& Batch, TArray<FVector2f>& OutPositions) const;
+
+	// The old per contact path (FRotator, RotateVector, normalize and rescale in double precision), only kept to benchmark the kernel against.
+	static int32 ProjectReference(float RadarYaw, float Range, float RadiusInPixels, const TArray<FVector>& Offsets, TArray<FVector2f>& OutPositions);
+
+protected:
+	// Rotation with the world to pixel scale already folded in.
+	float ScaledCos;
+	float ScaledSin;
+	float RangeSquared;
+	float Center;
+};
@@ -3,16 +3,20 @@
 #pragma once
 
 #include "CoreMinimal.h"
-#include "Blueprint/UserWidget.h"
+#include "HUDUserWidget.h"
 #include "RadarUserWidget.generated.h"
 
 /**
  * 
  */
 UCLASS()
-class GRAVITYFPSTEST_API URadarUserWidget : public UUserWidget
+class GRAVITYFPSTEST_API URadarUserWidget : public UHUDUserWidget
 {
 	GENERATED_BODY()
+public:
+	URadarUserWidget(const FObjectInitializer& ObjectInitializer);
+
+private:
 	virtual bool Initialize() override;
 
 	virtual void NativeTick(const FGeometry& MyGeometry, float InDeltaTime) override;
@@ -0,0 +1,50 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Widgets/SLeafWidget.h"
+#include "Styling/CoreStyle.h"
+
+/**
+ * Slate leaf widget that draws every radar blip in a single paint pass, one box element per blip.
+ * Positions are in the widget's local space (pixels from the top left corner), and every blip shares the same brush so Slate can batch them.
+ * A blip can stand for a cluster of contacts, in which case it is drawn larger and labelled with how many contacts it holds.
+ */
+class GRAVITYFPSTEST_API SRadarBlips : public SLeafWidget
+{
+public:
+	SLATE_BEGIN_ARGS(SRadarBlips)
+		: _BlipBrush(nullptr)
+		, _BlipSize(FVector2D(8.0f, 8.0f))
+		, _BlipColor(FLinearColor::Red)
+		, _CountFont(FCoreStyle::GetDefaultFontStyle("Bold", 8))
+	{}
+		SLATE_ARGUMENT(const FSlateBrush*, BlipBrush)
+		SLATE_ARGUMENT(FVector2D, BlipSize)
+		SLATE_ARGUMENT(FLinearColor, BlipColor)
+		SLATE_ARGUMENT(FSlateFontInfo, CountFont)
+	SLATE_END_ARGS()
+
+	void Construct(const FArguments& InArgs);
+
+	// Counts is either empty, meaning every blip is a single contact, or holds one entry per position.
+	void SetBlips(TArrayView<const FVector2f> InPositions, TArrayView<const int32> InCounts = TArrayView<const int32>());
+	void SetBlipStyle(const FSlateBrush* InBrush, const FVector2D& InSize, const FLinearColor& InColor);
+	void SetCountFont(const FSlateFontInfo& InFont);
+
+	virtual int32 OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements,
+		int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const override;
+
+protected:
+	virtual FVector2D ComputeDesiredSize(float LayoutScaleMultiplier) const override;
+
+	TArray<FVector2f> Positions;
+	TArray<int32> Counts;
+	// Labels for the clusters, built when the blips change rather than every paint.
+	TArray<FString> CountLabels;
+	const FSlateBrush* BlipBrush;
+	FVector2f BlipSize;
+	FLinearColor BlipColor;
+	FSlateFontInfo CountFont;
+};